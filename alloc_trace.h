@@ -0,0 +1,269 @@
+#if !defined(ALLOC_TRACE_H)
+/* ========================================================================
+   $File: alloc_trace.h $
+   $Date: Sat, 17 Oct 26: 05:05PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define ALLOC_TRACE_H
+#include "types.h"
+#include "defines.h"
+#include "debug.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum alloc_trace_event_type
+{
+    ALLOC_TRACE_PUSH,          // Arena, Size, Alignment
+    ALLOC_TRACE_BEGIN_SCRATCH, // Arena
+    ALLOC_TRACE_END_SCRATCH,   // Arena
+    ALLOC_TRACE_CLEAR,         // Arena
+    ALLOC_TRACE_LIST_CREATE,   // Elements, Stride, Capacity
+    ALLOC_TRACE_LIST_GROW,     // Old Elements, New Elements, New Capacity
+    ALLOC_TRACE_LIST_DESTROY,  // Elements
+
+    ALLOC_TRACE_EVENT_COUNT
+};
+
+constexpr uint32 ALLOC_TRACE_MAGIC   = 0x43525441; // "ATRC"
+constexpr uint32 ALLOC_TRACE_VERSION = 2;
+
+// NOTE(Sleepster): Never handed out. NULL gets it (a list with nothing allocated yet), and
+// events about NULL aren't recorded, there's nothing there to replay
+constexpr uint32 ALLOC_TRACE_NULL_ID = 0;
+
+// NOTE(Sleepster): Define ARENA_TRACE before including arena.h/list.h to compile the hooks in.
+// Even then nothing is recorded until AllocTraceBegin opens a file. Events are a type byte
+// followed by LEB128 varints, the arenas and lists they talk about are replaced by small ids
+// (first come first serve, starting at 1) so the trace doesn't depend on where anything was in memory.
+#if defined(ARENA_TRACE)
+
+#if !defined(ALLOC_TRACE_BUFFER_SIZE)
+#define ALLOC_TRACE_BUFFER_SIZE KB(64)
+#endif
+
+#if !defined(ALLOC_TRACE_MAX_OBJECTS)
+#define ALLOC_TRACE_MAX_OBJECTS 65536
+#endif
+
+struct alloc_trace_object
+{
+    void   *Pointer;
+    uint32  Id;
+};
+
+struct alloc_trace_state
+{
+    FILE           *File;
+    uint32          Used;
+    uint8           Buffer[ALLOC_TRACE_BUFFER_SIZE];
+
+    uint32          NextId;
+    alloc_trace_object Objects[ALLOC_TRACE_MAX_OBJECTS];
+
+    uint64          EventCount;
+    bool8           Full;
+    volatile int32  Lock;
+};
+
+global_variable alloc_trace_state *AllocTraceState;
+
+#define AllocTrace(Type, Object, ...) { if(AllocTraceState) AllocTraceRecord(Type, Object, ##__VA_ARGS__); }
+
+internal void
+AllocTraceFlush(alloc_trace_state *State)
+{
+    if(State->Used)
+    {
+        fwrite(State->Buffer, State->Used, 1, State->File);
+        State->Used = 0;
+    }
+}
+
+internal inline void
+AllocTraceWriteVarint(alloc_trace_state *State, uint64 Value)
+{
+    do
+    {
+        uint8 Byte = Value & 0x7F;
+        Value >>= 7;
+        State->Buffer[State->Used++] = Byte | (Value ? 0x80 : 0);
+    } while(Value);
+}
+
+#define ALLOC_TRACE_TOMBSTONE ((void *)UINTPTR_MAX)
+#define ALLOC_TRACE_NO_ID     0xFFFFFFFF
+
+// NOTE(Sleepster): Hands back the slot Pointer lives in, or the slot it should be put in.
+// 0 if Pointer isn't in the table and there's no room left for it.
+internal alloc_trace_object*
+AllocTraceFindObject(alloc_trace_state *State, void *Pointer)
+{
+    uint64 Hash  = (uint64)Pointer * 0x9E3779B97F4A7C15ULL;
+    uint32 Index = (uint32)(Hash >> 32) & (ALLOC_TRACE_MAX_OBJECTS - 1);
+
+    alloc_trace_object *Tombstone = 0;
+    for(uint32 Probe = 0;
+        Probe < ALLOC_TRACE_MAX_OBJECTS;
+        ++Probe)
+    {
+        alloc_trace_object *Object = &State->Objects[Index];
+        if(Object->Pointer == Pointer) return(Object);
+        if(!Object->Pointer) return(Tombstone ? Tombstone : Object);
+        if(Object->Pointer == ALLOC_TRACE_TOMBSTONE && !Tombstone) Tombstone = Object;
+
+        Index = (Index + 1) & (ALLOC_TRACE_MAX_OBJECTS - 1);
+    }
+
+    return(Tombstone);
+}
+
+internal uint32
+AllocTraceGetObjectId(alloc_trace_state *State, void *Pointer)
+{
+    if(!Pointer) return(ALLOC_TRACE_NULL_ID);
+
+    alloc_trace_object *Object = AllocTraceFindObject(State, Pointer);
+    if(!Object) return(ALLOC_TRACE_NO_ID);
+
+    if(Object->Pointer != Pointer)
+    {
+        Object->Pointer = Pointer;
+        Object->Id      = State->NextId++;
+    }
+
+    return(Object->Id);
+}
+
+// NOTE(Sleepster): Lists move to a new pointer when they grow, this keeps their id the same.
+// Growing from NULL is the list's first allocation, so it just gets a new id.
+internal uint32
+AllocTraceRenameObject(alloc_trace_state *State, void *OldPointer, void *NewPointer)
+{
+    if(!OldPointer) return(AllocTraceGetObjectId(State, NewPointer));
+
+    uint32 Result = AllocTraceGetObjectId(State, OldPointer);
+    if(Result == ALLOC_TRACE_NO_ID) return(Result);
+
+    // NOTE(Sleepster): Can't fail, tombstoning the old slot just made room
+    AllocTraceFindObject(State, OldPointer)->Pointer = ALLOC_TRACE_TOMBSTONE;
+
+    alloc_trace_object *Object = AllocTraceFindObject(State, NewPointer);
+    Object->Pointer = NewPointer;
+    Object->Id      = Result;
+
+    return(Result);
+}
+
+internal void
+AllocTraceRecord(alloc_trace_event_type Type, void *Object, uint64 A = 0, uint64 B = 0)
+{
+    alloc_trace_state *State = AllocTraceState;
+    while(AtomicCompareExchange32(&State->Lock, 0, 1) != 0) {}
+
+    if(State->Full)
+    {
+        AtomicCompareExchange32(&State->Lock, 1, 0);
+        return;
+    }
+
+    uint32 Id = (Type == ALLOC_TRACE_LIST_GROW) ? AllocTraceRenameObject(State, Object, (void *)A) : AllocTraceGetObjectId(State, Object);
+    if(Id == ALLOC_TRACE_NO_ID)
+    {
+        // NOTE(Sleepster): Everything after this would be missing ids, so the trace just ends here
+        Log(LOG_ERROR, "Trace object table is full ('%u' objects), no more events will be recorded. Bump ALLOC_TRACE_MAX_OBJECTS...", ALLOC_TRACE_MAX_OBJECTS);
+        State->Full = true;
+        AtomicCompareExchange32(&State->Lock, 1, 0);
+        return;
+    }
+    if(Id == ALLOC_TRACE_NULL_ID)
+    {
+        AtomicCompareExchange32(&State->Lock, 1, 0);
+        return;
+    }
+
+    // NOTE(Sleepster): Type byte plus up to 3 varints of 10 bytes each
+    if((State->Used + 31) > ALLOC_TRACE_BUFFER_SIZE)
+    {
+        AllocTraceFlush(State);
+    }
+
+    State->Buffer[State->Used++] = (uint8)Type;
+    AllocTraceWriteVarint(State, Id);
+    switch(Type)
+    {
+        case ALLOC_TRACE_PUSH:
+        case ALLOC_TRACE_LIST_CREATE:
+        {
+            AllocTraceWriteVarint(State, A);
+            AllocTraceWriteVarint(State, B);
+        }break;
+        case ALLOC_TRACE_LIST_GROW:
+        {
+            AllocTraceWriteVarint(State, B);
+        }break;
+        case ALLOC_TRACE_LIST_DESTROY:
+        {
+            // NOTE(Sleepster): Free the slot, the allocator will hand the address out again
+            AllocTraceFindObject(State, Object)->Pointer = ALLOC_TRACE_TOMBSTONE;
+        }break;
+        default: break;
+    }
+    ++State->EventCount;
+
+    AtomicCompareExchange32(&State->Lock, 1, 0);
+}
+
+internal bool8
+AllocTraceBegin(const char *Filepath)
+{
+    Assert(!AllocTraceState, "An allocation trace is already being recorded!");
+
+    FILE *File = fopen(Filepath, "wb");
+    if(!File)
+    {
+        fprintf(stderr, "Failed to open '%s' for the allocation trace!\n", Filepath);
+        return(false);
+    }
+
+    uint32 Header[2] = {ALLOC_TRACE_MAGIC, ALLOC_TRACE_VERSION};
+    fwrite(Header, sizeof(Header), 1, File);
+
+    alloc_trace_state *State = (alloc_trace_state *)calloc(1, sizeof(alloc_trace_state));
+    State->File   = File;
+    State->NextId = ALLOC_TRACE_NULL_ID + 1;
+
+    WriteBarrier;
+    AllocTraceState = State;
+    return(true);
+}
+
+// NOTE(Sleepster): Only call this once nothing else is allocating
+internal void
+AllocTraceEnd()
+{
+    alloc_trace_state *State = AllocTraceState;
+    if(State)
+    {
+        while(AtomicCompareExchange32(&State->Lock, 0, 1) != 0) {}
+        AllocTraceState = 0;
+
+        AllocTraceFlush(State);
+        fclose(State->File);
+        free(State);
+    }
+}
+
+#else
+
+#define AllocTrace(Type, Object, ...)
+
+internal inline bool8 AllocTraceBegin(const char *) { return(false); }
+internal inline void  AllocTraceEnd() {}
+
+#endif // ARENA_TRACE
+
+#endif // ALLOC_TRACE_H
@@ -0,0 +1,321 @@
+#if !defined(ALLOC_TRACE_REPLAY_H)
+/* ========================================================================
+   $File: alloc_trace_replay.h $
+   $Date: Sat, 17 Oct 26: 05:48PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define ALLOC_TRACE_REPLAY_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+#include "list.h"
+#include "alloc_trace.h"
+
+#include <time.h>
+
+constexpr int32 ALLOC_TRACE_REPLAY_MAX_SCRATCH_DEPTH = 32;
+
+enum alloc_trace_replay_arena_kind
+{
+    REPLAY_ARENA_FIXED,   // Every arena gets its own ArenaSize pool
+    REPLAY_ARENA_VIRTUAL, // Every arena reserves ArenaSize and commits as it goes
+    REPLAY_ARENA_CHAINED, // Every arena links ArenaSize blocks out of one shared PoolSize pool
+};
+
+struct alloc_trace_replay_config
+{
+    uint32       ArenaKind;
+    memory_index ArenaSize;
+    memory_index PoolSize;
+
+    bool8        UseHugePages;
+    bool8        TouchMemory;
+};
+
+struct alloc_trace_replay_stats
+{
+    uint64       EventCounts[ALLOC_TRACE_EVENT_COUNT];
+    uint64       BytesPushed;
+    uint64       FailedPushes;
+    memory_index PeakArenaUsed;
+    uint32       ObjectCount;
+    real64       Seconds;
+};
+
+struct alloc_trace_replay_object
+{
+    bool8          IsList;
+    bool8          Initialized;
+
+    memory_pool    Pool;
+    memory_arena   Arena;
+    memory_index   PeakUsed;
+    int32          ScratchDepth;
+    scratch_memory ScratchStack[ALLOC_TRACE_REPLAY_MAX_SCRATCH_DEPTH];
+
+    list           List;
+};
+
+internal inline uint64
+AllocTraceReadVarint(uint8 **At, uint8 *End)
+{
+    uint64 Result = 0;
+    for(int32 Shift = 0;
+        *At < End && Shift < 64;
+        Shift += 7)
+    {
+        uint8 Byte = *(*At)++;
+        Result |= (uint64)(Byte & 0x7F) << Shift;
+        if(!(Byte & 0x80)) break;
+    }
+
+    return(Result);
+}
+
+internal inline real64
+AllocTraceReplayGetSeconds()
+{
+    timespec Time;
+    timespec_get(&Time, TIME_UTC);
+    return((real64)Time.tv_sec + ((real64)Time.tv_nsec / 1000000000.0));
+}
+
+internal memory_pool
+AllocTraceReplayCreatePool(alloc_trace_replay_config *Config, memory_index Size)
+{
+    memory_pool Result = Config->UseHugePages ? InitializeHugePageMemoryPool(Size) : InitializeMemoryPool(Size);
+    return(Result);
+}
+
+internal void
+AllocTraceReplayReleasePool(memory_pool *Pool)
+{
+    if(Pool->PageKind == POOL_PAGES_ALLOCATOR) free(Pool->MemoryBlock);
+    else                                       ReleaseMemoryPool(Pool);
+    *Pool = {};
+}
+
+internal memory_arena*
+AllocTraceReplayGetArena(alloc_trace_replay_config *Config, memory_pool *SharedPool, alloc_trace_replay_object *Object)
+{
+    if(!Object->Initialized)
+    {
+        switch(Config->ArenaKind)
+        {
+            case REPLAY_ARENA_FIXED:
+            {
+                Object->Pool  = AllocTraceReplayCreatePool(Config, Config->ArenaSize);
+                Object->Arena = InitializeArena(&Object->Pool, Config->ArenaSize);
+            }break;
+            case REPLAY_ARENA_VIRTUAL:
+            {
+                Object->Arena = InitializeVirtualArena(Config->ArenaSize);
+            }break;
+            case REPLAY_ARENA_CHAINED:
+            {
+                Object->Arena = InitializeChainedArena(SharedPool->MemoryBlock ? SharedPool : 0, Config->ArenaSize);
+            }break;
+        }
+        Object->Initialized = true;
+    }
+
+    return(&Object->Arena);
+}
+
+// NOTE(Sleepster): Plays a trace recorded with ARENA_TRACE back against the arena setup in
+// Config, so different configurations can be compared on a real allocation pattern
+internal alloc_trace_replay_stats
+AllocTraceReplay(const char *Filepath, alloc_trace_replay_config *Config)
+{
+    alloc_trace_replay_stats Result = {};
+
+    FILE *File = fopen(Filepath, "rb");
+    if(!File)
+    {
+        Log(LOG_ERROR, "Failed to open the allocation trace '%s'!", Filepath);
+        return(Result);
+    }
+
+    fseek(File, 0, SEEK_END);
+    memory_index FileSize = (memory_index)ftell(File);
+    fseek(File, 0, SEEK_SET);
+
+    uint8 *Trace = (uint8 *)malloc(FileSize);
+    memory_index BytesRead = fread(Trace, 1, FileSize, File);
+    fclose(File);
+
+    uint32 *Header = (uint32 *)Trace;
+    if(BytesRead != FileSize || FileSize < 8 || Header[0] != ALLOC_TRACE_MAGIC || Header[1] != ALLOC_TRACE_VERSION)
+    {
+        Log(LOG_ERROR, "'%s' is not a valid allocation trace!", Filepath);
+        free(Trace);
+        return(Result);
+    }
+
+    memory_pool SharedPool = {};
+    if(Config->ArenaKind == REPLAY_ARENA_CHAINED && Config->PoolSize)
+    {
+        SharedPool = AllocTraceReplayCreatePool(Config, Config->PoolSize);
+    }
+
+    uint32 ObjectCapacity = 256;
+    alloc_trace_replay_object *Objects = (alloc_trace_replay_object *)calloc(ObjectCapacity, sizeof(alloc_trace_replay_object));
+
+    real64 StartTime = AllocTraceReplayGetSeconds();
+
+    uint8 *At  = Trace + 8;
+    uint8 *End = Trace + FileSize;
+    while(At < End)
+    {
+        uint8  Type = *At++;
+        uint64 Id   = AllocTraceReadVarint(&At, End);
+        if(Type >= ALLOC_TRACE_EVENT_COUNT || Id == ALLOC_TRACE_NULL_ID) break;
+
+        if(Id >= ObjectCapacity)
+        {
+            uint32 NewCapacity = ObjectCapacity;
+            while(Id >= NewCapacity) NewCapacity *= 2;
+
+            Objects = (alloc_trace_replay_object *)realloc(Objects, NewCapacity * sizeof(alloc_trace_replay_object));
+            memset(Objects + ObjectCapacity, 0, (NewCapacity - ObjectCapacity) * sizeof(alloc_trace_replay_object));
+
+            // NOTE(Sleepster): The objects just moved, so any scratch block that's still open
+            // points at the arena's old address
+            for(uint32 Index = 0;
+                Index < ObjectCapacity;
+                ++Index)
+            {
+                alloc_trace_replay_object *Moved = &Objects[Index];
+                int32 OpenCount = Moved->ScratchDepth < ALLOC_TRACE_REPLAY_MAX_SCRATCH_DEPTH ? Moved->ScratchDepth : ALLOC_TRACE_REPLAY_MAX_SCRATCH_DEPTH;
+                for(int32 Depth = 0;
+                    Depth < OpenCount;
+                    ++Depth)
+                {
+                    Moved->ScratchStack[Depth].Arena = &Moved->Arena;
+                }
+            }
+            ObjectCapacity = NewCapacity;
+        }
+        if(Id > Result.ObjectCount) Result.ObjectCount = (uint32)Id;
+
+        alloc_trace_replay_object *Object = &Objects[Id];
+        ++Result.EventCounts[Type];
+
+        switch(Type)
+        {
+            case ALLOC_TRACE_PUSH:
+            {
+                memory_index Size      = AllocTraceReadVarint(&At, End);
+                memory_index Alignment = AllocTraceReadVarint(&At, End);
+
+                memory_arena *Arena = AllocTraceReplayGetArena(Config, &SharedPool, Object);
+                uint8 *Memory = (uint8 *)PushSize_(Arena, Size, Alignment);
+                if(Memory)
+                {
+                    if(Config->TouchMemory) memset(Memory, 0, Size);
+                    Result.BytesPushed += Size;
+                    if(Arena->Used > Object->PeakUsed) Object->PeakUsed = Arena->Used;
+                }
+                else
+                {
+                    ++Result.FailedPushes;
+                }
+            }break;
+            case ALLOC_TRACE_BEGIN_SCRATCH:
+            {
+                memory_arena *Arena = AllocTraceReplayGetArena(Config, &SharedPool, Object);
+                if(Object->ScratchDepth < ALLOC_TRACE_REPLAY_MAX_SCRATCH_DEPTH)
+                {
+                    Object->ScratchStack[Object->ScratchDepth] = BeginScratchBlock(Arena);
+                }
+                ++Object->ScratchDepth;
+            }break;
+            case ALLOC_TRACE_END_SCRATCH:
+            {
+                if(Object->ScratchDepth > 0)
+                {
+                    --Object->ScratchDepth;
+                    if(Object->ScratchDepth < ALLOC_TRACE_REPLAY_MAX_SCRATCH_DEPTH)
+                    {
+                        EndScratchBlock(&Object->ScratchStack[Object->ScratchDepth]);
+                    }
+                }
+            }break;
+            case ALLOC_TRACE_CLEAR:
+            {
+                ClearArena(AllocTraceReplayGetArena(Config, &SharedPool, Object));
+                Object->ScratchDepth = 0;
+            }break;
+            case ALLOC_TRACE_LIST_CREATE:
+            {
+                uint64 Stride   = AllocTraceReadVarint(&At, End);
+                uint64 Capacity = AllocTraceReadVarint(&At, End);
+
+                if(Object->IsList) ListDestroy(&Object->List);
+                Object->List   = _ListCreate(Stride, Capacity);
+                Object->IsList = true;
+            }break;
+            case ALLOC_TRACE_LIST_GROW:
+            {
+                // NOTE(Sleepster): A list that first allocates by growing (created empty) has no
+                // CREATE event to take its stride from, so there's nothing to grow here
+                uint64 NewCapacity = AllocTraceReadVarint(&At, End);
+                if(Object->IsList)
+                {
+                    while(Object->List.Capacity < NewCapacity) ListGrow(&Object->List);
+                }
+            }break;
+            case ALLOC_TRACE_LIST_DESTROY:
+            {
+                if(Object->IsList) ListDestroy(&Object->List);
+                Object->IsList = false;
+            }break;
+        }
+    }
+
+    Result.Seconds = AllocTraceReplayGetSeconds() - StartTime;
+
+    for(uint32 Index = 1;
+        Index <= Result.ObjectCount;
+        ++Index)
+    {
+        alloc_trace_replay_object *Object = &Objects[Index];
+        Result.PeakArenaUsed += Object->PeakUsed;
+
+        if(Object->IsList) ListDestroy(&Object->List);
+        if(Object->Initialized)
+        {
+            switch(Config->ArenaKind)
+            {
+                case REPLAY_ARENA_FIXED:   AllocTraceReplayReleasePool(&Object->Pool); break;
+                case REPLAY_ARENA_VIRTUAL: ReleaseVirtualArena(&Object->Arena);        break;
+                case REPLAY_ARENA_CHAINED: ReleaseChainedArena(&Object->Arena);        break;
+            }
+        }
+    }
+    if(SharedPool.MemoryBlock) AllocTraceReplayReleasePool(&SharedPool);
+
+    free(Objects);
+    free(Trace);
+
+    return(Result);
+}
+
+internal void
+AllocTraceReplayLogStats(alloc_trace_replay_stats *Stats)
+{
+    Log(LOG_INFO, "Replay: %.3fms, %llu pushes (%llu bytes, %llu failed), %llu scratch blocks, %llu clears, %llu list grows, peak arena use %llu bytes over %u objects",
+        Stats->Seconds * 1000.0,
+        (unsigned long long)Stats->EventCounts[ALLOC_TRACE_PUSH],
+        (unsigned long long)Stats->BytesPushed,
+        (unsigned long long)Stats->FailedPushes,
+        (unsigned long long)Stats->EventCounts[ALLOC_TRACE_BEGIN_SCRATCH],
+        (unsigned long long)Stats->EventCounts[ALLOC_TRACE_CLEAR],
+        (unsigned long long)Stats->EventCounts[ALLOC_TRACE_LIST_GROW],
+        (unsigned long long)Stats->PeakArenaUsed,
+        Stats->ObjectCount);
+}
+
+#endif // ALLOC_TRACE_REPLAY_H
@@ -9,18 +9,80 @@
 #define ARENA_H
 #include "types.h"
 #include "debug.h"
+#include "arena_telemetry.h"
+#include "alloc_trace.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ARENA_USE_SSE2 1
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 typedef size_t memory_index;
 
+#if !defined(POOL_HUGE_PAGE_SIZE)
+#define POOL_HUGE_PAGE_SIZE MB(2)
+#endif
+
+#if !defined(CACHE_LINE_SIZE)
+#define CACHE_LINE_SIZE 64
+#endif
+
+// NOTE(Sleepster): Zeroing anything bigger than this bypasses the cache
+#if !defined(ARENA_STREAMING_ZERO_THRESHOLD)
+#define ARENA_STREAMING_ZERO_THRESHOLD KB(256)
+#endif
+
+#if !defined(ARENA_COMMIT_GRANULARITY)
+#define ARENA_COMMIT_GRANULARITY KB(64)
+#endif
+
+enum memory_arena_flags
+{
+    ARENA_FLAG_NONE    = 0,
+    ARENA_FLAG_VIRTUAL = 1 << 0,
+    ARENA_FLAG_CHAINED = 1 << 1,
+};
+
+// NOTE(Sleepster): What actually ended up backing a memory_pool
+enum memory_pool_page_kind
+{
+    POOL_PAGES_ALLOCATOR,        // Whatever the allocator_func handed us
+    POOL_PAGES_STANDARD,         // Mapped by us, regular pages
+    POOL_PAGES_TRANSPARENT_HUGE, // Mapped by us, the kernel was asked to back it with huge pages
+    POOL_PAGES_HUGETLB,          // Mapped by us, explicit huge pages
+};
+
 struct memory_pool
 {
     void  *MemoryBlock;
     uint8 *BlockOffset; 
 
     memory_index BlockSize;
+    uint32       PageKind;
+};
+
+// NOTE(Sleepster): Lives at the front of every block a chained arena links in,
+// it remembers what the arena looked like before the block was pushed
+struct memory_arena_block
+{
+    memory_arena_block *Prev;
+
+    uint8        *PrevBase;
+    memory_index  PrevCapacity;
+    memory_index  PrevUsed;
+
+    memory_index  BlockSize;
+    bool8         FromPool;
 };
 
 struct memory_arena
@@ -29,17 +91,117 @@ struct memory_arena
     memory_index  Used;
     uint8        *Base;
 
-    int32 ScratchCount;
+    int32  ScratchCount;
+    uint32 Flags;
+
+    // NOTE(Sleepster): Virtual arenas only, Capacity is the reserved range and
+    // Committed is how much of it is actually backed by pages right now
+    memory_index Committed;
+    memory_index DecommitThreshold;
+
+    // NOTE(Sleepster): Highest Used has been since the pages were committed. Everything past
+    // max(DirtyMark, Used) is still fresh zero pages from the OS, so zeroed pushes skip it.
+    memory_index DirtyMark;
+
+    // NOTE(Sleepster): Chained arenas only, FreeBlocks holds popped pool blocks
+    // since the pool has no way to take them back
+    memory_pool        *Pool;
+    memory_index        MinimumBlockSize;
+    memory_arena_block *CurrentBlock;
+    memory_arena_block *FreeBlocks;
+
+#if defined(ARENA_TELEMETRY)
+    arena_telemetry Telemetry;
+#endif
 };
 
 struct scratch_memory
 {
-    memory_arena *Arena;
-    memory_index  Used;
+    memory_arena       *Arena;
+    memory_arena_block *Block;
+    memory_index        Used;
 };
 
 typedef void*(*allocator_func)(uint64 Size);
 
+internal inline memory_index
+PlatformGetPageSize()
+{
+#if defined(_WIN32)
+    SYSTEM_INFO SystemInfo;
+    GetSystemInfo(&SystemInfo);
+    return((memory_index)SystemInfo.dwPageSize);
+#else
+    return((memory_index)sysconf(_SC_PAGESIZE));
+#endif
+}
+
+internal inline memory_index
+AlignUpPow2(memory_index Value, memory_index Alignment)
+{
+    return((Value + (Alignment - 1)) & ~(Alignment - 1));
+}
+
+internal inline memory_index
+GetAlignmentOffsetForAddress(memory_index Address, memory_index Alignment = 4)
+{
+    memory_index AlignmentMask = Alignment - 1;
+
+    memory_index AlignmentOffset = 0;
+    if(Address & AlignmentMask) // If the memory is misaligned
+    {
+        AlignmentOffset = Alignment - (Address & AlignmentMask); // align it 
+    }
+
+    return(AlignmentOffset);
+}
+
+// NOTE(Sleepster): Reserves address space only, nothing is resident until it's committed
+internal void*
+PlatformReserveMemory(memory_index Size)
+{
+#if defined(_WIN32)
+    void *Result = VirtualAlloc(0, Size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void *Result = mmap(0, Size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+    if(Result == MAP_FAILED) Result = 0;
+#endif
+    return(Result);
+}
+
+internal bool8
+PlatformCommitMemory(void *Memory, memory_index Size)
+{
+#if defined(_WIN32)
+    bool8 Result = (VirtualAlloc(Memory, Size, MEM_COMMIT, PAGE_READWRITE) != 0);
+#else
+    bool8 Result = (mprotect(Memory, Size, PROT_READ|PROT_WRITE) == 0);
+#endif
+    return(Result);
+}
+
+// NOTE(Sleepster): Gives the pages back to the OS, they read back as zero when recommitted
+internal void
+PlatformDecommitMemory(void *Memory, memory_index Size)
+{
+#if defined(_WIN32)
+    VirtualFree(Memory, Size, MEM_DECOMMIT);
+#else
+    madvise(Memory, Size, MADV_DONTNEED);
+    mprotect(Memory, Size, PROT_NONE);
+#endif
+}
+
+internal void
+PlatformReleaseMemory(void *Memory, memory_index Size)
+{
+#if defined(_WIN32)
+    VirtualFree(Memory, 0, MEM_RELEASE);
+#else
+    munmap(Memory, Size);
+#endif
+}
+
 // TODO(Sleepster): Replace malloc here
 internal memory_pool
 InitializeMemoryPool(usize Size, allocator_func Allocator = *malloc)
@@ -54,24 +216,116 @@ InitializeMemoryPool(usize Size, allocator_func Allocator = *malloc)
     return(Result);
 }
 
+// NOTE(Sleepster): Tries explicit huge pages first, then transparent huge pages, then regular
+// pages, PageKind says which one we got. Prefault touches every page up front so the page
+// faults happen here rather than the first time an arena walks into them.
+internal memory_pool
+InitializeHugePageMemoryPool(usize Size, bool8 Prefault = false)
+{
+    memory_pool Result = {};
+    Result.BlockSize = AlignUpPow2(Size, POOL_HUGE_PAGE_SIZE);
+
+#if defined(_WIN32)
+    memory_index LargePageSize = GetLargePageMinimum();
+    if(LargePageSize)
+    {
+        Result.BlockSize   = AlignUpPow2(Size, LargePageSize);
+        Result.MemoryBlock = VirtualAlloc(0, Result.BlockSize, MEM_RESERVE|MEM_COMMIT|MEM_LARGE_PAGES, PAGE_READWRITE);
+        Result.PageKind    = POOL_PAGES_HUGETLB;
+    }
+
+    if(!Result.MemoryBlock)
+    {
+        Result.MemoryBlock = VirtualAlloc(0, Result.BlockSize, MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
+        Result.PageKind    = POOL_PAGES_STANDARD;
+    }
+#else
+#if defined(MAP_HUGETLB)
+    int32 PopulateFlag = 0;
+#if defined(MAP_POPULATE)
+    if(Prefault) PopulateFlag = MAP_POPULATE;
+#endif
+    void *HugeBlock = mmap(0, Result.BlockSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB|PopulateFlag, -1, 0);
+    if(HugeBlock != MAP_FAILED)
+    {
+        Result.MemoryBlock = HugeBlock;
+        Result.PageKind    = POOL_PAGES_HUGETLB;
+    }
+#endif
+
+    if(!Result.MemoryBlock)
+    {
+        // NOTE(Sleepster): Over-map by a huge page and trim it so the block starts on a huge page
+        // boundary, otherwise the kernel can't use a huge page for the first and last bits of it
+        memory_index MappedSize = Result.BlockSize + POOL_HUGE_PAGE_SIZE;
+        uint8 *Mapped = (uint8 *)mmap(0, MappedSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if(Mapped != MAP_FAILED)
+        {
+            uint8 *Aligned = Mapped + GetAlignmentOffsetForAddress((memory_index)Mapped, POOL_HUGE_PAGE_SIZE);
+            if(Aligned != Mapped) munmap(Mapped, Aligned - Mapped);
+            memory_index TailSize = (Mapped + MappedSize) - (Aligned + Result.BlockSize);
+            if(TailSize) munmap(Aligned + Result.BlockSize, TailSize);
+
+            Result.MemoryBlock = Aligned;
+            Result.PageKind    = POOL_PAGES_STANDARD;
+#if defined(MADV_HUGEPAGE)
+            if(madvise(Aligned, Result.BlockSize, MADV_HUGEPAGE) == 0)
+            {
+                Result.PageKind = POOL_PAGES_TRANSPARENT_HUGE;
+            }
+#endif
+        }
+    }
+#endif
+
+    if(!Result.MemoryBlock)
+    {
+        Log(LOG_ERROR, "Failed to map a memory pool of '%llu' bytes!", (unsigned long long)Result.BlockSize);
+        Result.BlockSize = 0;
+        return(Result);
+    }
+
+    if(Prefault && Result.PageKind != POOL_PAGES_HUGETLB)
+    {
+        memory_index PageSize = PlatformGetPageSize();
+        for(memory_index Offset = 0;
+            Offset < Result.BlockSize;
+            Offset += PageSize)
+        {
+            ((volatile uint8 *)Result.MemoryBlock)[Offset] = 0;
+        }
+    }
+
+    Result.BlockOffset = (uint8 *)Result.MemoryBlock;
+
+    const char *PageKindNames[] = {"allocator", "standard pages", "transparent huge pages", "explicit huge pages"};
+    Log(LOG_INFO, "Memory Pool Initialized with a size of %llu, backed by %s", (unsigned long long)Result.BlockSize, PageKindNames[Result.PageKind]);
+
+    return(Result);
+}
+
+// NOTE(Sleepster): Only for pools we mapped ourselves, allocator_func pools belong to whoever allocated them
+internal void
+ReleaseMemoryPool(memory_pool *Pool)
+{
+    Assert(Pool->PageKind != POOL_PAGES_ALLOCATOR, "Memory pool was not mapped by InitializeHugePageMemoryPool!");
+    if(Pool->MemoryBlock)
+    {
+        PlatformReleaseMemory(Pool->MemoryBlock, Pool->BlockSize);
+    }
+    *Pool = {};
+}
+
 // TODO(Sleepster): Add the ability to "free" the memory of the arena
-#define PushSize(Arena, size, ...)                 PushSize_(Arena, size * sizeof(uint8), ##__VA_ARGS__)
-#define PushStruct(Arena, type, ...)       (type *)PushSize_(Arena, sizeof(type), ##__VA_ARGS__)
-#define PushArray(Arena, type, Count, ...) (type *)PushSize_(Arena, sizeof(type) * (Count), ##__VA_ARGS__)
+#define PushSize(Arena, size, ...)                 (ArenaTelemetryCallsite PushSize_(Arena, size * sizeof(uint8), ##__VA_ARGS__))
+#define PushStruct(Arena, type, ...)       (type *)(ArenaTelemetryCallsite PushSize_(Arena, sizeof(type), ##__VA_ARGS__))
+#define PushArray(Arena, type, Count, ...) (type *)(ArenaTelemetryCallsite PushSize_(Arena, sizeof(type) * (Count), ##__VA_ARGS__))
 
 internal inline memory_index
 GetAlignmentOffset(memory_arena *Arena, memory_index Alignment = 4)
 {
     memory_index Offset = (memory_index)Arena->Base + Arena->Used;
-    memory_index AlignmentMask = Alignment - 1;
-
-    memory_index AlignmentOffset = 0;
-    if(Offset & AlignmentMask) // If the memory is misaligned
-    {
-        AlignmentOffset = Alignment - (Offset & AlignmentMask); // align it 
-    }
-
-    return(AlignmentOffset);
+    return(GetAlignmentOffsetForAddress(Offset, Alignment));
 }
 
 internal inline memory_index
@@ -81,20 +335,226 @@ ArenaGetRemainingSize(memory_arena *Arena, memory_index Alignment)
     return(Result);
 }
 
+internal bool8
+ArenaCommit(memory_arena *Arena, memory_index RequiredSize)
+{
+    if(RequiredSize > Arena->Capacity)
+    {
+        Log(LOG_ERROR, "Virtual arena allocation would exceed the reserved range of '%llu' bytes!", (unsigned long long)Arena->Capacity);
+        return(false);
+    }
+
+    memory_index NewCommitted = AlignUpPow2(RequiredSize, ARENA_COMMIT_GRANULARITY);
+    if(NewCommitted > Arena->Capacity) NewCommitted = Arena->Capacity;
+
+    if(!PlatformCommitMemory(Arena->Base + Arena->Committed, NewCommitted - Arena->Committed))
+    {
+        Log(LOG_ERROR, "Failed to commit '%llu' bytes of virtual arena memory!", (unsigned long long)(NewCommitted - Arena->Committed));
+        return(false);
+    }
+
+    Arena->Committed = NewCommitted;
+    return(true);
+}
+
+global_variable const memory_index ARENA_BLOCK_HEADER_SIZE = AlignUpPow2(sizeof(memory_arena_block), 16);
+
+internal void
+ArenaPushBlock(memory_arena *Arena, memory_index MinimumSize, memory_index Alignment)
+{
+    // NOTE(Sleepster): Rounded so the next block carved out of the pool gets an aligned header too
+    memory_index BlockSize = AlignUpPow2(MinimumSize + Alignment + ARENA_BLOCK_HEADER_SIZE, 16);
+    if(BlockSize < Arena->MinimumBlockSize) BlockSize = AlignUpPow2(Arena->MinimumBlockSize, 16);
+
+    memory_arena_block *Block = 0;
+    for(memory_arena_block **FreeBlock = &Arena->FreeBlocks;
+        *FreeBlock;
+        FreeBlock = &(*FreeBlock)->Prev)
+    {
+        if((*FreeBlock)->BlockSize >= BlockSize)
+        {
+            Block = *FreeBlock;
+            *FreeBlock = Block->Prev;
+            break;
+        }
+    }
+
+    if(!Block)
+    {
+        memory_pool *Pool = Arena->Pool;
+        uint8 *BlockStart = Pool ? Pool->BlockOffset + GetAlignmentOffsetForAddress((memory_index)Pool->BlockOffset, 16) : 0;
+        if(Pool && (memory_index)((BlockStart + BlockSize) - (uint8 *)Pool->MemoryBlock) <= Pool->BlockSize)
+        {
+            Block = (memory_arena_block *)BlockStart;
+            Pool->BlockOffset = BlockStart + BlockSize;
+            Block->FromPool = true;
+        }
+        else
+        {
+            Block = (memory_arena_block *)malloc(BlockSize);
+            Assert(Block, "Failed to allocate a new arena block...");
+            Block->FromPool = false;
+        }
+        Block->BlockSize = BlockSize;
+    }
+
+    Block->Prev         = Arena->CurrentBlock;
+    Block->PrevBase     = Arena->Base;
+    Block->PrevCapacity = Arena->Capacity;
+    Block->PrevUsed     = Arena->Used;
+
+    Arena->CurrentBlock = Block;
+    Arena->Base         = (uint8 *)Block + ARENA_BLOCK_HEADER_SIZE;
+    Arena->Capacity     = Block->BlockSize - ARENA_BLOCK_HEADER_SIZE;
+    Arena->Used         = 0;
+}
+
+internal void
+ArenaPopBlock(memory_arena *Arena)
+{
+    memory_arena_block *Block = Arena->CurrentBlock;
+    Assert(Block, "Arena has no blocks to pop...");
+
+    Arena->CurrentBlock = Block->Prev;
+    Arena->Base         = Block->PrevBase;
+    Arena->Capacity     = Block->PrevCapacity;
+    Arena->Used         = Block->PrevUsed;
+
+    if(Block->FromPool)
+    {
+        Block->Prev = Arena->FreeBlocks;
+        Arena->FreeBlocks = Block;
+    }
+    else
+    {
+        free(Block);
+    }
+}
+
 internal void*
 PushSize_(memory_arena *Arena, memory_index Size, memory_index Alignment = 4)
 {
+#if defined(ARENA_TELEMETRY)
+    const char *TelemetryFile;
+    int32       TelemetryLine;
+    ArenaTelemetryTakeCallsite(&TelemetryFile, &TelemetryLine);
+#endif
     memory_index AlignmentOffset = GetAlignmentOffset(Arena, Alignment);
+    if((Arena->Flags & ARENA_FLAG_CHAINED) && (Arena->Used + Size + AlignmentOffset) > Arena->Capacity)
+    {
+        ArenaPushBlock(Arena, Size, Alignment);
+        AlignmentOffset = GetAlignmentOffset(Arena, Alignment);
+    }
+#if defined(ARENA_TELEMETRY)
+    memory_index RequestedSize = Size;
+#endif
     Size += AlignmentOffset;
 
-    Assert((Arena->Used + Size) <= Arena->Capacity, "Arena allocation would exceed the capacity!");
+    if((Arena->Flags & ARENA_FLAG_VIRTUAL) && (Arena->Used + Size) > Arena->Committed)
+    {
+        if(!ArenaCommit(Arena, Arena->Used + Size)) return(0);
+    }
+
+    if((Arena->Used + Size) > Arena->Capacity)
+    {
+        Assert(false, "Arena allocation would exceed the capacity!");
+        Log(LOG_ERROR, "Arena allocation of '%llu' bytes would exceed the capacity!", (unsigned long long)Size);
+        return(0);
+    }
 
     void *Result = (void *)(Arena->Base + Arena->Used + AlignmentOffset);
     Arena->Used += Size;
 
+#if defined(ARENA_TELEMETRY)
+    ArenaTelemetryRecord(&Arena->Telemetry, TelemetryFile, TelemetryLine, Arena->Used, RequestedSize, AlignmentOffset);
+#endif
+    AllocTrace(ALLOC_TRACE_PUSH, Arena, Size - AlignmentOffset, Alignment);
+
+    return(Result);
+}
+
+// NOTE(Sleepster): Anything that moves Used backwards has to call this first
+internal inline void
+ArenaMarkDirty(memory_arena *Arena)
+{
+    if(Arena->Used > Arena->DirtyMark) Arena->DirtyMark = Arena->Used;
+}
+
+// NOTE(Sleepster): Non-temporal stores go around the cache, so zeroing megabytes doesn't
+// evict everything else we're working with
+internal void
+ZeroMemoryStreaming(void *Memory, memory_index Size)
+{
+#if defined(ARENA_USE_SSE2)
+    if(Size >= ARENA_STREAMING_ZERO_THRESHOLD)
+    {
+        uint8 *At = (uint8 *)Memory;
+        memory_index HeadSize = GetAlignmentOffsetForAddress((memory_index)At, 16);
+        memset(At, 0, HeadSize);
+        At   += HeadSize;
+        Size -= HeadSize;
+
+        __m128i Zero = _mm_setzero_si128();
+        memory_index BodySize = Size & ~(memory_index)63;
+        for(uint8 *End = At + BodySize;
+            At < End;
+            At += 64)
+        {
+            _mm_stream_si128((__m128i *)(At +  0), Zero);
+            _mm_stream_si128((__m128i *)(At + 16), Zero);
+            _mm_stream_si128((__m128i *)(At + 32), Zero);
+            _mm_stream_si128((__m128i *)(At + 48), Zero);
+        }
+        _mm_sfence();
+
+        memset(At, 0, Size - BodySize);
+        return;
+    }
+#endif
+    memset(Memory, 0, Size);
+}
+
+#define PushSizeZero(Arena, size, ...)                 PushSizeZero_(Arena, size * sizeof(uint8), ##__VA_ARGS__)
+#define PushStructZero(Arena, type, ...)       (type *)PushSizeZero_(Arena, sizeof(type), ##__VA_ARGS__)
+#define PushArrayZero(Arena, type, Count, ...) (type *)PushSizeZero_(Arena, sizeof(type) * (Count), ##__VA_ARGS__)
+
+// NOTE(Sleepster): Only zeroes what might actually be dirty. On a virtual arena anything past
+// the DirtyMark came straight from the OS and is already zero.
+internal void*
+PushSizeZero_(memory_arena *Arena, memory_index Size, memory_index Alignment = 4)
+{
+    ArenaMarkDirty(Arena);
+    memory_index DirtyMark = Arena->DirtyMark;
+
+    uint8 *Result = (uint8 *)PushSize_(Arena, Size, Alignment);
+    if(Result)
+    {
+        memory_index DirtySize = Size;
+        if(Arena->Flags & ARENA_FLAG_VIRTUAL)
+        {
+            memory_index Start = Result - Arena->Base;
+            DirtySize = (DirtyMark > Start) ? (DirtyMark - Start) : 0;
+            if(DirtySize > Size) DirtySize = Size;
+        }
+
+        ZeroMemoryStreaming(Result, DirtySize);
+    }
+
     return(Result);
 }
 
+#define PushSizeCacheAligned(Arena, size)                 PushSizeCacheAligned_(Arena, size * sizeof(uint8))
+#define PushStructCacheAligned(Arena, type)       (type *)PushSizeCacheAligned_(Arena, sizeof(type))
+#define PushArrayCacheAligned(Arena, type, Count) (type *)PushSizeCacheAligned_(Arena, sizeof(type) * (Count))
+
+// NOTE(Sleepster): Starts on a cache line and is padded out to a whole number of them, so
+// nothing else pushed onto the arena can share a line with it (no false sharing between threads)
+internal inline void*
+PushSizeCacheAligned_(memory_arena *Arena, memory_index Size)
+{
+    return(PushSize_(Arena, AlignUpPow2(Size, CACHE_LINE_SIZE), CACHE_LINE_SIZE));
+}
+
 // TODO(Sleepster): Make this simply take a memory offset rather than a memory block
 internal inline memory_arena 
 InitializeArena(memory_pool *BlockBuffer, memory_index Capacity)
@@ -109,6 +569,71 @@ InitializeArena(memory_pool *BlockBuffer, memory_index Capacity)
     return(Arena);
 }
 
+// NOTE(Sleepster): Reserves ReserveSize bytes of address space and commits it in
+// ARENA_COMMIT_GRANULARITY steps as PushSize_ walks into it. If DecommitThreshold is
+// non-zero, ClearArena hands every page above it back to the OS.
+internal memory_arena
+InitializeVirtualArena(memory_index ReserveSize, memory_index DecommitThreshold = 0)
+{
+    memory_index PageSize = PlatformGetPageSize();
+
+    memory_arena Arena = {};
+    Arena.Capacity          = AlignUpPow2(ReserveSize, PageSize);
+    Arena.Base              = (uint8 *)PlatformReserveMemory(Arena.Capacity);
+    Arena.Flags             = ARENA_FLAG_VIRTUAL;
+    Arena.DecommitThreshold = AlignUpPow2(DecommitThreshold, ARENA_COMMIT_GRANULARITY);
+
+    if(!Arena.Base)
+    {
+        Log(LOG_ERROR, "Failed to reserve '%llu' bytes for a virtual arena!", (unsigned long long)Arena.Capacity);
+        Arena.Capacity = 0;
+    }
+
+    return(Arena);
+}
+
+internal void
+ReleaseVirtualArena(memory_arena *Arena)
+{
+    Assert(Arena->Flags & ARENA_FLAG_VIRTUAL, "Arena is not a virtual arena!");
+    if(Arena->Base)
+    {
+        PlatformReleaseMemory(Arena->Base, Arena->Capacity);
+    }
+    *Arena = {};
+}
+
+// NOTE(Sleepster): Starts out empty and links in a new block (from Pool while it
+// has room, malloc after that) every time a push doesn't fit. Blocks are at least
+// MinimumBlockSize, oversized pushes get a block of their own.
+internal inline memory_arena
+InitializeChainedArena(memory_pool *Pool, memory_index MinimumBlockSize = MB(1))
+{
+    memory_arena Arena = {};
+    Arena.Flags            = ARENA_FLAG_CHAINED;
+    Arena.Pool             = Pool;
+    Arena.MinimumBlockSize = MinimumBlockSize;
+
+    return(Arena);
+}
+
+// NOTE(Sleepster): malloc'd blocks are freed. Blocks carved out of the pool can't go back to it
+// (pools only bump forward), so they stay on FreeBlocks and the arena is left empty but usable,
+// pushing onto it again reuses them instead of carving more out of the pool.
+internal void
+ReleaseChainedArena(memory_arena *Arena)
+{
+    Assert(Arena->Flags & ARENA_FLAG_CHAINED, "Arena is not a chained arena!");
+    while(Arena->CurrentBlock)
+    {
+        ArenaPopBlock(Arena);
+    }
+
+    memory_arena Result = InitializeChainedArena(Arena->Pool, Arena->MinimumBlockSize);
+    Result.FreeBlocks = Arena->FreeBlocks;
+    *Arena = Result;
+}
+
 internal inline memory_arena
 InitializeSubArena(memory_arena *Arena, memory_index Capacity, memory_index Alignment = 4)
 {
@@ -124,9 +649,11 @@ BeginScratchBlock(memory_arena *Arena)
 {
     scratch_memory Result;
     Result.Arena = Arena;
+    Result.Block = Arena->CurrentBlock;
     Result.Used  = Arena->Used;
 
     ++Arena->ScratchCount;
+    AllocTrace(ALLOC_TRACE_BEGIN_SCRATCH, Arena);
     return(Result);
 }
 
@@ -134,17 +661,39 @@ internal inline void
 EndScratchBlock(scratch_memory *Scratch)
 {
     memory_arena *Arena = Scratch->Arena;
+    while(Arena->CurrentBlock != Scratch->Block)
+    {
+        ArenaPopBlock(Arena);
+    }
+
     Assert(Arena->Used >= Scratch->Used, "Scratch memory pointer not valid...");
     Assert(Arena->ScratchCount > 0, "Cannot decrement arena scratch counter! It is already 0...");
 
+    ArenaMarkDirty(Arena);
     Arena->Used = Scratch->Used;
     Arena->ScratchCount--;
+    AllocTrace(ALLOC_TRACE_END_SCRATCH, Arena);
 }
 
 internal inline void
 ClearArena(memory_arena *Arena)
 {
+    AllocTrace(ALLOC_TRACE_CLEAR, Arena);
+    while(Arena->CurrentBlock)
+    {
+        ArenaPopBlock(Arena);
+    }
+    ArenaMarkDirty(Arena);
     Arena->Used = 0;
+
+    if((Arena->Flags & ARENA_FLAG_VIRTUAL) &&
+       Arena->DecommitThreshold &&
+       Arena->Committed > Arena->DecommitThreshold)
+    {
+        PlatformDecommitMemory(Arena->Base + Arena->DecommitThreshold, Arena->Committed - Arena->DecommitThreshold);
+        Arena->Committed = Arena->DecommitThreshold;
+        if(Arena->DirtyMark > Arena->Committed) Arena->DirtyMark = Arena->Committed;
+    }
 }
 
 #endif // ARENA_H
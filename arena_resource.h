@@ -0,0 +1,101 @@
+#if !defined(ARENA_RESOURCE_H)
+/* ========================================================================
+   $File: arena_resource.h $
+   $Date: Sat, 17 Oct 26: 02:04PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define ARENA_RESOURCE_H
+
+// NOTE(Sleepster): The standard headers use "internal" as an identifier (ios_base::internal)
+#pragma push_macro("internal")
+#undef internal
+#include <memory_resource>
+#include <new>
+#pragma pop_macro("internal")
+
+#include "types.h"
+#include "arena.h"
+
+// NOTE(Sleepster): Lets std::pmr containers allocate straight out of a memory_arena. Freeing
+// does nothing unless it's the most recent allocation (which is what vector growth looks like),
+// everything else goes away when the arena is cleared or the scratch block ends.
+struct arena_memory_resource : public std::pmr::memory_resource
+{
+    memory_arena *Arena;
+
+    // NOTE(Sleepster): Where the arena was when we were made, we never roll Used back past this
+    // or while somebody else has a scratch block open on top of us
+    memory_arena_block *FloorBlock;
+    uint8              *Floor;
+    int32               ScratchCount;
+
+    explicit arena_memory_resource(memory_arena *Arena)
+        : Arena(Arena)
+    {
+        MarkFloor();
+    }
+
+    void MarkFloor()
+    {
+        FloorBlock   = Arena->CurrentBlock;
+        Floor        = Arena->Base + Arena->Used;
+        ScratchCount = Arena->ScratchCount;
+    }
+
+protected:
+    void *do_allocate(size_t Bytes, size_t Alignment) override
+    {
+        void *Result = PushSize_(Arena, Bytes, Alignment);
+        if(!Result)
+        {
+            throw std::bad_alloc();
+        }
+
+        return(Result);
+    }
+
+    void do_deallocate(void *Memory, size_t Bytes, size_t) override
+    {
+        uint8 *Top = Arena->Base + Arena->Used;
+        bool8 AboveFloor = (Arena->CurrentBlock != FloorBlock) || ((uint8 *)Memory >= Floor);
+        if(Arena->ScratchCount == ScratchCount &&
+           AboveFloor &&
+           (uint8 *)Memory >= Arena->Base &&
+           ((uint8 *)Memory + Bytes) == Top)
+        {
+            ArenaMarkDirty(Arena);
+            Arena->Used -= Bytes;
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &Other) const noexcept override
+    {
+        const arena_memory_resource *OtherArena = dynamic_cast<const arena_memory_resource *>(&Other);
+        return(OtherArena && OtherArena->Arena == Arena);
+    }
+};
+
+// NOTE(Sleepster): Opens a scratch block on the arena for as long as it's alive. Every container
+// using it has to be destroyed first, they are all freed in one go when this goes out of scope.
+struct scoped_arena_resource : public arena_memory_resource
+{
+    scratch_memory Scratch;
+
+    explicit scoped_arena_resource(memory_arena *Arena)
+        : arena_memory_resource(Arena), Scratch(BeginScratchBlock(Arena))
+    {
+        MarkFloor();
+    }
+
+    ~scoped_arena_resource()
+    {
+        EndScratchBlock(&Scratch);
+    }
+
+    scoped_arena_resource(const scoped_arena_resource &) = delete;
+    scoped_arena_resource &operator=(const scoped_arena_resource &) = delete;
+};
+
+#endif // ARENA_RESOURCE_H
@@ -0,0 +1,207 @@
+#if !defined(ARENA_SNAPSHOT_H)
+/* ========================================================================
+   $File: arena_snapshot.h $
+   $Date: Sat, 17 Oct 26: 04:12PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define ARENA_SNAPSHOT_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+#include "custom_string.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr uint32       ARENA_SNAPSHOT_MAGIC   = 0x50414E53; // "SNAP"
+constexpr uint32       ARENA_SNAPSHOT_VERSION = 1;
+constexpr memory_index ARENA_SNAPSHOT_PAGE    = KB(4);
+
+// NOTE(Sleepster): Pointer that stores the distance from itself to what it points at, so a
+// structure made out of these means the same thing wherever the arena ends up in memory.
+// Both ends have to live in the same arena, and it can't point at itself (that's null).
+template <typename type>
+struct arena_ptr
+{
+    int64 Offset;
+
+    arena_ptr() : Offset(0) {}
+    arena_ptr(type *Pointer) { Set(Pointer); }
+    arena_ptr(const arena_ptr &Other) { Set(Other.Get()); }
+
+    arena_ptr &operator=(const arena_ptr &Other) { Set(Other.Get()); return(*this); }
+    arena_ptr &operator=(type *Pointer)          { Set(Pointer);     return(*this); }
+
+    void Set(type *Pointer)
+    {
+        Offset = Pointer ? ((uint8 *)Pointer - (uint8 *)this) : 0;
+    }
+
+    type *Get() const
+    {
+        return(Offset ? (type *)((uint8 *)this + Offset) : 0);
+    }
+
+    type *operator->() const              { return(Get()); }
+    type &operator*() const               { return(*Get()); }
+    type &operator[](int64 Index) const   { return(Get()[Index]); }
+    explicit operator bool() const        { return(Offset != 0); }
+};
+
+// NOTE(Sleepster): The data starts at the same offset within a page as the arena's Base did,
+// so anything aligned to a page or less in the original arena stays aligned once it's mapped
+struct arena_snapshot_header
+{
+    uint32 Magic;
+    uint32 Version;
+    uint64 Used;
+    uint64 DataOffset;
+    uint64 RootOffset;
+};
+
+struct arena_snapshot
+{
+    memory_arena  Arena;
+    void         *Root;
+
+    void         *Mapping;
+    memory_index  MappingSize;
+};
+
+#define ArenaSnapshotRoot(Snapshot, type) ((type *)(Snapshot)->Root)
+
+// NOTE(Sleepster): Root is what you want back when loading (usually the first thing pushed)
+internal bool8
+WriteArenaSnapshot(memory_arena *Arena, void *Root, string Filepath)
+{
+    Assert(!(Arena->Flags & ARENA_FLAG_CHAINED), "Chained arenas aren't contiguous and can't be snapshotted!");
+    Assert(!Root || ((uint8 *)Root >= Arena->Base && (uint8 *)Root < Arena->Base + Arena->Used), "Snapshot root is not inside the arena!");
+
+    arena_snapshot_header Header = {};
+    Header.Magic      = ARENA_SNAPSHOT_MAGIC;
+    Header.Version    = ARENA_SNAPSHOT_VERSION;
+    Header.Used       = Arena->Used;
+    Header.DataOffset = ARENA_SNAPSHOT_PAGE + ((memory_index)Arena->Base & (ARENA_SNAPSHOT_PAGE - 1));
+    Header.RootOffset = Root ? ((uint8 *)Root - Arena->Base) : UINT64_MAX;
+
+    FILE *File = fopen(CSTR(Filepath), "wb");
+    if(!File)
+    {
+        Log(LOG_ERROR, "Failed to open '%s' to write an arena snapshot!", CSTR(Filepath));
+        return(false);
+    }
+
+    uint8 Padding[ARENA_SNAPSHOT_PAGE * 2] = {};
+    bool8 Success = (fwrite(&Header, sizeof(Header), 1, File) == 1);
+    Success = Success && (fwrite(Padding, Header.DataOffset - sizeof(Header), 1, File) == 1);
+    Success = Success && (!Arena->Used || fwrite(Arena->Base, Arena->Used, 1, File) == 1);
+    fclose(File);
+
+    if(!Success)
+    {
+        Log(LOG_ERROR, "Failed to write the arena snapshot '%s'!", CSTR(Filepath));
+    }
+
+    return(Success);
+}
+
+internal void
+UnloadArenaSnapshot(arena_snapshot *Snapshot)
+{
+    if(Snapshot->Mapping)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(Snapshot->Mapping);
+#else
+        munmap(Snapshot->Mapping, Snapshot->MappingSize);
+#endif
+    }
+    *Snapshot = {};
+}
+
+// NOTE(Sleepster): Maps the snapshot instead of reading it, so pages only come in as they are
+// touched. CopyOnWrite gives you a private writable copy, otherwise the mapping is read only.
+// The arena comes back full, pushing onto it isn't supported.
+internal arena_snapshot
+LoadArenaSnapshot(string Filepath, bool8 CopyOnWrite = false)
+{
+    arena_snapshot Result = {};
+
+#if defined(_WIN32)
+    HANDLE File = CreateFileA(CSTR(Filepath), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if(File == INVALID_HANDLE_VALUE)
+    {
+        Log(LOG_ERROR, "Failed to open the arena snapshot '%s'!", CSTR(Filepath));
+        return(Result);
+    }
+
+    LARGE_INTEGER FileSize;
+    GetFileSizeEx(File, &FileSize);
+
+    HANDLE Mapping = CreateFileMappingA(File, 0, CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, 0);
+    CloseHandle(File);
+    if(!Mapping)
+    {
+        Log(LOG_ERROR, "Failed to map the arena snapshot '%s'!", CSTR(Filepath));
+        return(Result);
+    }
+
+    Result.Mapping     = MapViewOfFile(Mapping, CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    Result.MappingSize = (memory_index)FileSize.QuadPart;
+    CloseHandle(Mapping);
+#else
+    int File = open(CSTR(Filepath), O_RDONLY);
+    if(File < 0)
+    {
+        Log(LOG_ERROR, "Failed to open the arena snapshot '%s'!", CSTR(Filepath));
+        return(Result);
+    }
+
+    struct stat FileStats;
+    fstat(File, &FileStats);
+    Result.MappingSize = (memory_index)FileStats.st_size;
+
+    int32 Protection = CopyOnWrite ? (PROT_READ|PROT_WRITE) : PROT_READ;
+    Result.Mapping = mmap(0, Result.MappingSize, Protection, MAP_PRIVATE, File, 0);
+    close(File);
+
+    if(Result.Mapping == MAP_FAILED) Result.Mapping = 0;
+#endif
+
+    if(!Result.Mapping)
+    {
+        Log(LOG_ERROR, "Failed to map the arena snapshot '%s'!", CSTR(Filepath));
+        Result.MappingSize = 0;
+        return(Result);
+    }
+
+    arena_snapshot_header *Header = (arena_snapshot_header *)Result.Mapping;
+    if(Result.MappingSize < sizeof(arena_snapshot_header) ||
+       Header->Magic != ARENA_SNAPSHOT_MAGIC ||
+       Header->Version != ARENA_SNAPSHOT_VERSION ||
+       Header->Used > Result.MappingSize ||
+       Header->DataOffset > (Result.MappingSize - Header->Used) ||
+       (Header->RootOffset != UINT64_MAX && Header->RootOffset >= Header->Used))
+    {
+        Log(LOG_ERROR, "'%s' is not a valid arena snapshot!", CSTR(Filepath));
+        UnloadArenaSnapshot(&Result);
+        return(Result);
+    }
+
+    Result.Arena.Base     = (uint8 *)Result.Mapping + Header->DataOffset;
+    Result.Arena.Capacity = Header->Used;
+    Result.Arena.Used     = Header->Used;
+    Result.Root = (Header->RootOffset != UINT64_MAX) ? (Result.Arena.Base + Header->RootOffset) : 0;
+
+    return(Result);
+}
+
+#endif // ARENA_SNAPSHOT_H
@@ -0,0 +1,231 @@
+#if !defined(ARENA_TELEMETRY_H)
+/* ========================================================================
+   $File: arena_telemetry.h $
+   $Date: Sat, 17 Oct 26: 01:15PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define ARENA_TELEMETRY_H
+#include "types.h"
+#include "defines.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// NOTE(Sleepster): Define ARENA_TELEMETRY before including arena.h to turn this on. Every
+// PushSize/PushStruct/PushArray then records its __FILE__:__LINE__, the size it asked for
+// and the bytes lost to alignment. Without it everything here compiles down to nothing.
+#if defined(ARENA_TELEMETRY)
+
+#if !defined(ARENA_TELEMETRY_MAX_CALLSITES)
+#define ARENA_TELEMETRY_MAX_CALLSITES 4096
+#endif
+
+struct arena_telemetry
+{
+    uint64 HighWaterMark;
+    uint64 AllocationCount;
+    uint64 BytesRequested;
+    uint64 BytesWasted;
+};
+
+struct arena_callsite_stats
+{
+    const char *File;
+    int32       Line;
+
+    uint64      AllocationCount;
+    uint64      BytesRequested;
+    uint64      BytesWasted;
+};
+
+global_variable arena_callsite_stats ArenaTelemetryCallsites[ARENA_TELEMETRY_MAX_CALLSITES];
+global_variable int32                ArenaTelemetryCallsiteCount;
+global_variable volatile int32       ArenaTelemetryLock;
+
+global_variable thread_local const char *ArenaTelemetryFile;
+global_variable thread_local int32       ArenaTelemetryLine;
+
+#define ArenaTelemetryCallsite ArenaTelemetrySetCallsite(__FILE__, __LINE__),
+
+internal inline void
+ArenaTelemetrySetCallsite(const char *File, int32 Line)
+{
+    ArenaTelemetryFile = File;
+    ArenaTelemetryLine = Line;
+}
+
+// NOTE(Sleepster): PushSize_ calls this before it can fail so a push that returns 0 doesn't
+// leave its callsite behind for whatever the thread pushes next
+internal inline void
+ArenaTelemetryTakeCallsite(const char **File, int32 *Line)
+{
+    *File = ArenaTelemetryFile ? ArenaTelemetryFile : "(direct PushSize_)";
+    *Line = ArenaTelemetryFile ? ArenaTelemetryLine : 0;
+    ArenaTelemetryFile = 0;
+}
+
+internal arena_callsite_stats*
+ArenaTelemetryGetCallsite(const char *File, int32 Line)
+{
+    // NOTE(Sleepster): Hash the path itself, the compiler doesn't have to merge identical
+    // __FILE__ literals so two pointers can name the same file
+    uint64 Hash = 0xCBF29CE484222325ULL;
+    for(const char *Char = File;
+        *Char;
+        ++Char)
+    {
+        Hash = (Hash ^ (uint8)*Char) * 0x100000001B3ULL;
+    }
+    Hash = (Hash ^ (uint64)Line) * 0x9E3779B97F4A7C15ULL;
+    uint32 Index = (uint32)(Hash >> 32) & (ARENA_TELEMETRY_MAX_CALLSITES - 1);
+
+    for(int32 Probe = 0;
+        Probe < ARENA_TELEMETRY_MAX_CALLSITES;
+        ++Probe)
+    {
+        arena_callsite_stats *Callsite = &ArenaTelemetryCallsites[Index];
+        if(!Callsite->File)
+        {
+            Callsite->File = File;
+            Callsite->Line = Line;
+            ++ArenaTelemetryCallsiteCount;
+            return(Callsite);
+        }
+
+        if(Callsite->Line == Line && strcmp(Callsite->File, File) == 0)
+        {
+            return(Callsite);
+        }
+
+        Index = (Index + 1) & (ARENA_TELEMETRY_MAX_CALLSITES - 1);
+    }
+
+    return(0);
+}
+
+internal void
+ArenaTelemetryRecord(arena_telemetry *Stats, const char *File, int32 Line, uint64 Used, uint64 Size, uint64 Wasted)
+{
+    ++Stats->AllocationCount;
+    Stats->BytesRequested += Size;
+    Stats->BytesWasted    += Wasted;
+    if(Used > Stats->HighWaterMark) Stats->HighWaterMark = Used;
+
+    while(AtomicCompareExchange32(&ArenaTelemetryLock, 0, 1) != 0) {}
+
+    arena_callsite_stats *Callsite = ArenaTelemetryGetCallsite(File, Line);
+    if(Callsite)
+    {
+        ++Callsite->AllocationCount;
+        Callsite->BytesRequested += Size;
+        Callsite->BytesWasted    += Wasted;
+    }
+
+    AtomicCompareExchange32(&ArenaTelemetryLock, 1, 0);
+}
+
+internal int
+ArenaTelemetryCompareCallsites(const void *A, const void *B)
+{
+    const arena_callsite_stats *CallsiteA = (const arena_callsite_stats *)A;
+    const arena_callsite_stats *CallsiteB = (const arena_callsite_stats *)B;
+
+    if(CallsiteA->BytesRequested > CallsiteB->BytesRequested) return(-1);
+    if(CallsiteA->BytesRequested < CallsiteB->BytesRequested) return(1);
+    return(0);
+}
+
+// NOTE(Sleepster): Copies the used callsites out sorted by bytes requested, biggest first
+internal int32
+ArenaTelemetryGatherCallsites(arena_callsite_stats *Out)
+{
+    int32 Count = 0;
+
+    while(AtomicCompareExchange32(&ArenaTelemetryLock, 0, 1) != 0) {}
+    for(int32 Index = 0;
+        Index < ARENA_TELEMETRY_MAX_CALLSITES;
+        ++Index)
+    {
+        if(ArenaTelemetryCallsites[Index].File)
+        {
+            Out[Count++] = ArenaTelemetryCallsites[Index];
+        }
+    }
+    AtomicCompareExchange32(&ArenaTelemetryLock, 1, 0);
+
+    qsort(Out, Count, sizeof(arena_callsite_stats), ArenaTelemetryCompareCallsites);
+    return(Count);
+}
+
+internal void
+ArenaTelemetryDumpTable(FILE *Out = stdout)
+{
+    arena_callsite_stats *Callsites = (arena_callsite_stats *)malloc(sizeof(ArenaTelemetryCallsites));
+    int32 Count = ArenaTelemetryGatherCallsites(Callsites);
+
+    fprintf(Out, "%-60s %12s %16s %12s\n", "Callsite", "Count", "Bytes", "Wasted");
+    for(int32 Index = 0;
+        Index < Count;
+        ++Index)
+    {
+        arena_callsite_stats *Callsite = &Callsites[Index];
+
+        char Location[512];
+        snprintf(Location, sizeof(Location), "%s:%d", Callsite->File, Callsite->Line);
+        fprintf(Out, "%-60s %12llu %16llu %12llu\n", Location,
+                (unsigned long long)Callsite->AllocationCount,
+                (unsigned long long)Callsite->BytesRequested,
+                (unsigned long long)Callsite->BytesWasted);
+    }
+
+    free(Callsites);
+}
+
+internal void
+ArenaTelemetryDumpCSV(FILE *Out)
+{
+    arena_callsite_stats *Callsites = (arena_callsite_stats *)malloc(sizeof(ArenaTelemetryCallsites));
+    int32 Count = ArenaTelemetryGatherCallsites(Callsites);
+
+    fprintf(Out, "file,line,count,bytes,wasted\n");
+    for(int32 Index = 0;
+        Index < Count;
+        ++Index)
+    {
+        arena_callsite_stats *Callsite = &Callsites[Index];
+        fprintf(Out, "%s,%d,%llu,%llu,%llu\n", Callsite->File, Callsite->Line,
+                (unsigned long long)Callsite->AllocationCount,
+                (unsigned long long)Callsite->BytesRequested,
+                (unsigned long long)Callsite->BytesWasted);
+    }
+
+    free(Callsites);
+}
+
+internal void
+ArenaTelemetryDumpArena(const char *Name, arena_telemetry *Stats, FILE *Out = stdout)
+{
+    fprintf(Out, "%s: high water %llu, %llu allocations, %llu bytes requested, %llu bytes wasted to alignment\n", Name,
+            (unsigned long long)Stats->HighWaterMark,
+            (unsigned long long)Stats->AllocationCount,
+            (unsigned long long)Stats->BytesRequested,
+            (unsigned long long)Stats->BytesWasted);
+}
+
+#else
+
+#define ArenaTelemetryCallsite
+
+// NOTE(Sleepster): Empty so calls that name the type still compile with telemetry off
+struct arena_telemetry {};
+
+internal inline void ArenaTelemetryDumpTable(FILE * = stdout) {}
+internal inline void ArenaTelemetryDumpCSV(FILE *) {}
+internal inline void ArenaTelemetryDumpArena(const char *, arena_telemetry *, FILE * = stdout) {}
+
+#endif // ARENA_TELEMETRY
+
+#endif // ARENA_TELEMETRY_H
@@ -9,6 +9,12 @@
 #define ARRAY_H
 #include "types.h"
 #include "debug.h"
+#include "arena.h"
+
+#pragma push_macro("internal")
+#undef internal
+#include <type_traits>
+#pragma pop_macro("internal")
 
 // NOTE(Sleepster): This is limited to the stack
 struct array
@@ -22,13 +28,13 @@ struct array
 #define InitArray(arena, type, count) InitArray_(arena, sizeof(type), count) 
 
 internal inline array
-InitArray_(int32 ElementSize, int32 Capacity)
+InitArray_(memory_arena *Arena, int32 ElementSize, int32 Capacity)
 {
     array Result = {};
     Result.ElementSize = ElementSize;
     Result.Capacity    = Capacity;
     Result.Used        = 0;
-    Result.Data        = PushSize(ElementSize * Capacity);
+    Result.Data        = PushSize(Arena, ElementSize * Capacity);
 
     return(Result);
 }
@@ -42,9 +48,80 @@ GetArrayIndex(array *Array, int32 Index)
     }
     else
     {
-        Log(DEBUG_ERROR, "Target Index is out of range...\n");
+        Log(LOG_ERROR, "Target Index is out of range...\n");
         return(0);
     }
 }
 
+// NOTE(Sleepster): Capacity is part of the type, so indexing is a plain pointer offset and loops
+// over begin()/end() have a known stride the compiler can vectorize. Lives wherever you put it,
+// on the stack or in an arena through PushFixedArray.
+template <typename type, uint32 Count>
+struct fixed_array
+{
+    static_assert(std::is_trivially_copyable<type>::value, "fixed_array never constructs its slots, FixedArrayPush just copies over them");
+
+    static constexpr uint32 Capacity = Count;
+
+    uint32 Used;
+    type   Data[Count];
+
+    type       &operator[](uint32 Index)       { return(Data[Index]); }
+    const type &operator[](uint32 Index) const { return(Data[Index]); }
+
+    type *At(uint32 Index)
+    {
+        if(Index >= Used)
+        {
+            Log(LOG_ERROR, "Index '%u' is out of range, the array has '%u' elements...", Index, Used);
+            return(0);
+        }
+        return(Data + Index);
+    }
+
+    type       *begin()       { return(Data); }
+    type       *end()         { return(Data + Used); }
+    const type *begin() const { return(Data); }
+    const type *end()   const { return(Data + Used); }
+};
+
+#define PushFixedArray(Arena, type, Count) PushFixedArray_<type, Count>(Arena)
+
+template <typename type, uint32 Count>
+internal inline fixed_array<type, Count>*
+PushFixedArray_(memory_arena *Arena)
+{
+    memory_index Alignment = alignof(fixed_array<type, Count>) > 4 ? alignof(fixed_array<type, Count>) : 4;
+    fixed_array<type, Count> *Result = (fixed_array<type, Count> *)PushSize_(Arena, sizeof(fixed_array<type, Count>), Alignment);
+    if(Result)
+    {
+        // NOTE(Sleepster): Only Used needs to start at zero, Data is written before it's read
+        Result->Used = 0;
+    }
+
+    return(Result);
+}
+
+template <typename type, uint32 Count>
+internal inline type*
+FixedArrayPush(fixed_array<type, Count> *Array, const type &Value)
+{
+    if(Array->Used >= Count)
+    {
+        Log(LOG_ERROR, "Fixed array is full ('%u' elements)...", Count);
+        return(0);
+    }
+
+    type *Result = Array->Data + Array->Used++;
+    *Result = Value;
+    return(Result);
+}
+
+template <typename type, uint32 Count>
+internal inline void
+FixedArrayReset(fixed_array<type, Count> *Array)
+{
+    Array->Used = 0;
+}
+
 #endif
@@ -0,0 +1,94 @@
+#if !defined(BENCH_H)
+/* ========================================================================
+   $File: bench.h $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define BENCH_H
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "../types.h"
+#include "../defines.h"
+
+#pragma push_macro("internal")
+#undef internal
+#include <chrono>
+#pragma pop_macro("internal")
+
+// NOTE(Sleepster): Shared driver for the benchmarks in this folder. Every bench_*.cpp is its own
+// program, build them optimized from this folder:
+//
+//   g++ -std=c++20 -O2 -march=native -pthread bench_hash_map.cpp -o bench_hash_map
+//
+// BenchRun times Body a few times and reports the fastest run, so one unlucky page fault or
+// context switch doesn't end up in the numbers.
+
+#if !defined(BENCH_REPEATS)
+#define BENCH_REPEATS 5
+#endif
+
+internal inline real64
+BenchGetSeconds()
+{
+    auto Now = std::chrono::steady_clock::now().time_since_epoch();
+    return(std::chrono::duration<real64>(Now).count());
+}
+
+// NOTE(Sleepster): Stops the compiler from throwing away work whose result is never used
+template <typename type>
+internal inline void
+BenchKeep(const type &Value)
+{
+#if defined(_MSC_VER)
+    static volatile const void *Sink;
+    Sink = &Value;
+#else
+    asm volatile("" : : "r,m"(Value) : "memory");
+#endif
+}
+
+// NOTE(Sleepster): xorshift64*, the benchmarks need the same sequence every run and it has to be cheap
+internal inline uint64
+BenchRandom(uint64 *State)
+{
+    uint64 Value = *State;
+    Value ^= Value >> 12;
+    Value ^= Value << 25;
+    Value ^= Value >> 27;
+    *State = Value;
+
+    return(Value * 0x2545F4914F6CDD1DULL);
+}
+
+internal inline void
+BenchSection(const char *Title)
+{
+    printf("\n%s\n", Title);
+}
+
+// NOTE(Sleepster): Body does Operations operations per call, the result is the fastest call in seconds
+internal real64
+BenchRun(const char *Name, uint64 Operations, auto Body, int32 Repeats = BENCH_REPEATS)
+{
+    real64 Best = 1e30;
+    for(int32 Repeat = 0;
+        Repeat < Repeats;
+        ++Repeat)
+    {
+        real64 Start   = BenchGetSeconds();
+        Body();
+        real64 Elapsed = BenchGetSeconds() - Start;
+        if(Elapsed < Best) Best = Elapsed;
+    }
+
+    printf("  %-52s %10.2f ns/op %10.2f Mop/s\n", Name,
+           (Best * 1e9) / (real64)Operations, ((real64)Operations / Best) / 1e6);
+    fflush(stdout);
+    return(Best);
+}
+
+#endif // BENCH_H
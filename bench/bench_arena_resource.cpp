@@ -0,0 +1,96 @@
+/* ========================================================================
+   $File: bench_arena_resource.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.h"
+#include "../arena.h"
+#include "../arena_resource.h"
+
+// NOTE(Sleepster): One "request" builds a vector and a hash map the way a handler would and
+// then throws both away. With the arena that whole request is a scratch block.
+constexpr uint64 REQUEST_COUNT   = 1 << 14;
+constexpr uint32 VECTOR_ELEMENTS = 1024;
+constexpr uint32 MAP_ELEMENTS    = 256;
+
+internal void
+BenchRequest(std::pmr::memory_resource *Resource, uint64 Seed)
+{
+    std::pmr::vector<uint64> Values(Resource);
+    for(uint32 Index = 0;
+        Index < VECTOR_ELEMENTS;
+        ++Index)
+    {
+        Values.push_back(Seed + Index);
+    }
+
+    std::pmr::unordered_map<uint64, uint64> Lookup(Resource);
+    for(uint32 Index = 0;
+        Index < MAP_ELEMENTS;
+        ++Index)
+    {
+        Lookup[Values[(Index * 7) % VECTOR_ELEMENTS]] = Index;
+    }
+
+    BenchKeep(Lookup.size());
+}
+
+int
+main()
+{
+    memory_arena Arena = InitializeVirtualArena(GB(1));
+
+    BenchSection("Per-request std::pmr::vector + std::pmr::unordered_map");
+    BenchRun("std::pmr::new_delete_resource", REQUEST_COUNT, [&]()
+    {
+        for(uint64 Request = 0;
+            Request < REQUEST_COUNT;
+            ++Request)
+        {
+            BenchRequest(std::pmr::new_delete_resource(), Request);
+        }
+    });
+
+    BenchRun("std::pmr::monotonic_buffer_resource", REQUEST_COUNT, [&]()
+    {
+        for(uint64 Request = 0;
+            Request < REQUEST_COUNT;
+            ++Request)
+        {
+            std::pmr::monotonic_buffer_resource Resource;
+            BenchRequest(&Resource, Request);
+        }
+    });
+
+    BenchRun("arena_memory_resource, ClearArena per request", REQUEST_COUNT, [&]()
+    {
+        arena_memory_resource Resource(&Arena);
+        for(uint64 Request = 0;
+            Request < REQUEST_COUNT;
+            ++Request)
+        {
+            BenchRequest(&Resource, Request);
+            ClearArena(&Arena);
+        }
+    });
+
+    BenchRun("scoped_arena_resource per request", REQUEST_COUNT, [&]()
+    {
+        for(uint64 Request = 0;
+            Request < REQUEST_COUNT;
+            ++Request)
+        {
+            scoped_arena_resource Resource(&Arena);
+            BenchRequest(&Resource, Request);
+        }
+    });
+
+    ReleaseVirtualArena(&Arena);
+    return(0);
+}
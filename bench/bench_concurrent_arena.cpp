@@ -0,0 +1,110 @@
+/* ========================================================================
+   $File: bench_concurrent_arena.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "../arena.h"
+#include "../concurrent_arena.h"
+
+// NOTE(Sleepster): Every thread does the same number of small pushes, so perfect scaling shows
+// up as the ns/op (total pushes over wall time) dropping in line with the thread count.
+constexpr uint64       PUSHES_PER_THREAD = 1 << 18;
+constexpr memory_index PUSH_SIZE         = 24;
+constexpr memory_index PUSH_ALIGNMENT    = 8;
+
+internal void
+BenchRunThreads(int32 ThreadCount, auto Work)
+{
+    std::vector<std::thread> Threads;
+    for(int32 ThreadIndex = 0;
+        ThreadIndex < ThreadCount;
+        ++ThreadIndex)
+    {
+        Threads.emplace_back(Work, ThreadIndex);
+    }
+
+    for(std::thread &Thread : Threads) Thread.join();
+}
+
+int
+main()
+{
+    int32 MaxThreads = (int32)std::thread::hardware_concurrency();
+    if(MaxThreads < 1) MaxThreads = 1;
+
+    // NOTE(Sleepster): The fetch-add path reserves Size + Alignment - 1 for every push
+    memory_index Capacity = (memory_index)MaxThreads * PUSHES_PER_THREAD * (PUSH_SIZE + PUSH_ALIGNMENT) + MB(1);
+    memory_pool  Pool     = InitializeMemoryPool(Capacity);
+
+    memory_arena Locked = InitializeVirtualArena(Capacity);
+    std::mutex   LockedMutex;
+
+    concurrent_arena Shared = InitializeConcurrentArena(&Pool, Capacity);
+
+    for(int32 ThreadCount = 1;
+        ThreadCount <= MaxThreads;
+        ThreadCount = (ThreadCount * 2 < MaxThreads) ? ThreadCount * 2 : MaxThreads)
+    {
+        char Title[64];
+        snprintf(Title, sizeof(Title), "%d thread(s), %llu pushes each", ThreadCount, (unsigned long long)PUSHES_PER_THREAD);
+        BenchSection(Title);
+
+        uint64 Operations = (uint64)ThreadCount * PUSHES_PER_THREAD;
+        BenchRun("memory_arena behind a mutex", Operations, [&]()
+        {
+            ClearArena(&Locked);
+            BenchRunThreads(ThreadCount, [&](int32)
+            {
+                for(uint64 Index = 0;
+                    Index < PUSHES_PER_THREAD;
+                    ++Index)
+                {
+                    std::lock_guard<std::mutex> Guard(LockedMutex);
+                    BenchKeep(PushSize_(&Locked, PUSH_SIZE, PUSH_ALIGNMENT));
+                }
+            });
+        });
+
+        BenchRun("ConcurrentPushSize_ (shared fetch-add)", Operations, [&]()
+        {
+            ClearConcurrentArena(&Shared);
+            BenchRunThreads(ThreadCount, [&](int32)
+            {
+                for(uint64 Index = 0;
+                    Index < PUSHES_PER_THREAD;
+                    ++Index)
+                {
+                    BenchKeep(ConcurrentPushSize_(&Shared, PUSH_SIZE, PUSH_ALIGNMENT));
+                }
+            });
+        });
+
+        BenchRun("CachedPushSize_ (per-thread chunks)", Operations, [&]()
+        {
+            ClearConcurrentArena(&Shared);
+            BenchRunThreads(ThreadCount, [&](int32)
+            {
+                concurrent_arena_cache Cache = InitializeConcurrentArenaCache(&Shared);
+                for(uint64 Index = 0;
+                    Index < PUSHES_PER_THREAD;
+                    ++Index)
+                {
+                    BenchKeep(CachedPushSize_(&Cache, PUSH_SIZE, PUSH_ALIGNMENT));
+                }
+            });
+        });
+
+        if(ThreadCount == MaxThreads) break;
+    }
+
+    ReleaseVirtualArena(&Locked);
+    ReleaseMemoryPool(&Pool);
+    return(0);
+}
@@ -0,0 +1,152 @@
+/* ========================================================================
+   $File: bench_hash_map.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include <unordered_map>
+
+#include "bench.h"
+#include "../arena.h"
+#include "../hash_map.h"
+
+// NOTE(Sleepster): Random uint64 keys, inserted into an empty map (no reserve) and then looked
+// up in the same order. Misses use keys from a different sequence. The big sizes only get one
+// run each, std::unordered_map takes a while to build 10M nodes.
+internal void
+BenchHashMaps(uint64 Count)
+{
+    char Title[64];
+    snprintf(Title, sizeof(Title), "%llu entries", (unsigned long long)Count);
+    BenchSection(Title);
+
+    int32 Repeats = (Count >= 1000000) ? 1 : BENCH_REPEATS;
+
+    uint64 *Keys   = (uint64 *)malloc(Count * sizeof(uint64));
+    uint64 *Misses = (uint64 *)malloc(Count * sizeof(uint64));
+    uint64 KeyState  = 0x9E3779B97F4A7C15ULL;
+    uint64 MissState = 0xD1B54A32D192ED03ULL;
+    for(uint64 Index = 0;
+        Index < Count;
+        ++Index)
+    {
+        Keys[Index]   = BenchRandom(&KeyState);
+        Misses[Index] = BenchRandom(&MissState);
+    }
+
+    {
+        std::unordered_map<uint64, uint64> Map;
+        BenchRun("std::unordered_map insert", Count, [&]()
+        {
+            Map = std::unordered_map<uint64, uint64>();
+            for(uint64 Index = 0;
+                Index < Count;
+                ++Index)
+            {
+                Map[Keys[Index]] = Index;
+            }
+        }, Repeats);
+
+        BenchRun("std::unordered_map find (hit)", Count, [&]()
+        {
+            uint64 Sum = 0;
+            for(uint64 Index = 0;
+                Index < Count;
+                ++Index)
+            {
+                Sum += Map.find(Keys[Index])->second;
+            }
+            BenchKeep(Sum);
+        }, Repeats);
+
+        BenchRun("std::unordered_map find (miss)", Count, [&]()
+        {
+            uint64 Found = 0;
+            for(uint64 Index = 0;
+                Index < Count;
+                ++Index)
+            {
+                Found += (Map.find(Misses[Index]) != Map.end());
+            }
+            BenchKeep(Found);
+        }, Repeats);
+
+        BenchRun("std::unordered_map erase", Count, [&]()
+        {
+            for(uint64 Index = 0;
+                Index < Count;
+                ++Index)
+            {
+                Map.erase(Keys[Index]);
+            }
+        }, 1);
+    }
+
+    {
+        hash_map<uint64, uint64> Map;
+        InitializeHashMap(&Map);
+        BenchRun("hash_map insert", Count, [&]()
+        {
+            HashMapDestroy(&Map);
+            InitializeHashMap(&Map);
+            for(uint64 Index = 0;
+                Index < Count;
+                ++Index)
+            {
+                HashMapInsert(&Map, Keys[Index], Index);
+            }
+        }, Repeats);
+
+        BenchRun("hash_map find (hit)", Count, [&]()
+        {
+            uint64 Sum = 0;
+            for(uint64 Index = 0;
+                Index < Count;
+                ++Index)
+            {
+                Sum += *HashMapFind(&Map, Keys[Index]);
+            }
+            BenchKeep(Sum);
+        }, Repeats);
+
+        BenchRun("hash_map find (miss)", Count, [&]()
+        {
+            uint64 Found = 0;
+            for(uint64 Index = 0;
+                Index < Count;
+                ++Index)
+            {
+                Found += (HashMapFind(&Map, Misses[Index]) != 0);
+            }
+            BenchKeep(Found);
+        }, Repeats);
+
+        BenchRun("hash_map erase", Count, [&]()
+        {
+            for(uint64 Index = 0;
+                Index < Count;
+                ++Index)
+            {
+                HashMapErase(&Map, Keys[Index]);
+            }
+        }, 1);
+
+        HashMapDestroy(&Map);
+    }
+
+    free(Misses);
+    free(Keys);
+}
+
+int
+main()
+{
+    uint64 Counts[] = {1000, 10000, 100000, 1000000, 10000000};
+    for(uint64 Count : Counts)
+    {
+        BenchHashMaps(Count);
+    }
+
+    return(0);
+}
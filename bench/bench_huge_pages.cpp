@@ -0,0 +1,89 @@
+/* ========================================================================
+   $File: bench_huge_pages.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "bench.h"
+#include "../arena.h"
+
+// NOTE(Sleepster): Random reads over an arena that's far bigger than the TLB can cover with
+// 4KB pages. Pass the size of the array in MB as the first argument, it defaults to 1GB. Explicit huge
+// pages need some reserved first (/proc/sys/vm/nr_hugepages), otherwise you get THP or nothing.
+constexpr uint64 ACCESS_COUNT = 1 << 24;
+
+internal void
+BenchPool(const char *Name, memory_pool *Pool, real64 SetupSeconds)
+{
+    memory_arena Arena = InitializeArena(Pool, Pool->BlockSize);
+
+    // NOTE(Sleepster): Largest power of two that fits so the random indices are just a mask
+    uint64 Count = 1;
+    while(((Count * 2) * sizeof(uint64) + 64) <= Pool->BlockSize) Count *= 2;
+
+    uint64  Mask = Count - 1;
+    uint64 *Data = PushArray(&Arena, uint64, Count, 64);
+
+    real64 FillStart   = BenchGetSeconds();
+    uint64 RandomState = 0x9E3779B97F4A7C15ULL;
+    for(uint64 Index = 0;
+        Index < Count;
+        ++Index)
+    {
+        Data[Index] = BenchRandom(&RandomState);
+    }
+    real64 FillSeconds = BenchGetSeconds() - FillStart;
+
+    BenchSection(Name);
+    printf("  setup %.1f ms, first touch + fill %.1f ms\n", SetupSeconds * 1000.0, FillSeconds * 1000.0);
+
+    BenchRun("independent random reads", ACCESS_COUNT, [&]()
+    {
+        uint64 Sum   = 0;
+        uint64 State = 0xD1B54A32D192ED03ULL;
+        for(uint64 Access = 0;
+            Access < ACCESS_COUNT;
+            ++Access)
+        {
+            Sum += Data[BenchRandom(&State) & Mask];
+        }
+        BenchKeep(Sum);
+    });
+
+    BenchRun("dependent random reads (pointer chase)", ACCESS_COUNT, [&]()
+    {
+        uint64 Index = 0;
+        for(uint64 Access = 0;
+            Access < ACCESS_COUNT;
+            ++Access)
+        {
+            Index = (Data[Index] + Access) & Mask;
+        }
+        BenchKeep(Index);
+    });
+}
+
+int
+main(int ArgCount, char **Args)
+{
+    // NOTE(Sleepster): Room for the array plus the alignment it's pushed with
+    memory_index Size = MB(ArgCount > 1 ? atoi(Args[1]) : 1024) + POOL_HUGE_PAGE_SIZE;
+
+    real64 Start = BenchGetSeconds();
+    memory_pool Standard = InitializeMemoryPool(Size);
+    BenchPool("InitializeMemoryPool (malloc)", &Standard, BenchGetSeconds() - Start);
+    free(Standard.MemoryBlock);
+
+    Start = BenchGetSeconds();
+    memory_pool Huge = InitializeHugePageMemoryPool(Size);
+    BenchPool("InitializeHugePageMemoryPool", &Huge, BenchGetSeconds() - Start);
+    ReleaseMemoryPool(&Huge);
+
+    Start = BenchGetSeconds();
+    memory_pool Prefaulted = InitializeHugePageMemoryPool(Size, true);
+    BenchPool("InitializeHugePageMemoryPool, prefaulted", &Prefaulted, BenchGetSeconds() - Start);
+    ReleaseMemoryPool(&Prefaulted);
+
+    return(0);
+}
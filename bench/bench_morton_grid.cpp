@@ -0,0 +1,141 @@
+/* ========================================================================
+   $File: bench_morton_grid.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "bench.h"
+#include "../arena.h"
+#include "../custom_math.h"
+#include "../morton_grid.h"
+
+// NOTE(Sleepster): One 3x3 box blur pass per run over the interior cells, reading from one
+// grid and writing another. Row-major is the flat array we use today, the Morton grid is
+// walked both through its callbacks and tile by tile.
+internal void
+BenchStencil(int32 Size, memory_arena *Arena)
+{
+    char Title[64];
+    snprintf(Title, sizeof(Title), "%d x %d real32 grid, 3x3 stencil", Size, Size);
+    BenchSection(Title);
+
+    scratch_memory Scratch = BeginScratchBlock(Arena);
+
+    memory_index CellCount = (memory_index)Size * Size;
+    real32 *RowIn  = PushArray(Arena, real32, CellCount, 64);
+    real32 *RowOut = PushArray(Arena, real32, CellCount, 64);
+
+    morton_grid<real32> GridIn  = InitializeMortonGrid<real32>(Arena, Size, Size);
+    morton_grid<real32> GridOut = InitializeMortonGrid<real32>(Arena, Size, Size);
+
+    uint64 RandomState = 0x9E3779B97F4A7C15ULL;
+    for(int32 Y = 0;
+        Y < Size;
+        ++Y)
+    {
+        for(int32 X = 0;
+            X < Size;
+            ++X)
+        {
+            real32 Value = (real32)(BenchRandom(&RandomState) & 0xFF);
+            RowIn[(Y * Size) + X] = Value;
+            *MortonGridAt(&GridIn, ivec2{X, Y}) = Value;
+        }
+    }
+
+    uint64 Operations = (uint64)(Size - 2) * (Size - 2);
+    BenchRun("row-major array", Operations, [&]()
+    {
+        for(int32 Y = 1;
+            Y < Size - 1;
+            ++Y)
+        {
+            for(int32 X = 1;
+                X < Size - 1;
+                ++X)
+            {
+                real32 *Center = RowIn + (Y * Size) + X;
+                real32 Sum = Center[-Size - 1] + Center[-Size] + Center[-Size + 1] +
+                             Center[-1]        + Center[0]     + Center[1] +
+                             Center[Size - 1]  + Center[Size]  + Center[Size + 1];
+                RowOut[(Y * Size) + X] = Sum * (1.0f / 9.0f);
+            }
+        }
+        BenchKeep(RowOut[Size + 1]);
+    });
+
+    BenchRun("morton_grid, ForEachCell + ForEachNeighbor", Operations, [&]()
+    {
+        MortonGridForEachCell(&GridIn, [&](ivec2 Position, real32 *Cell)
+        {
+            if(Position.X < 1 || Position.Y < 1 || Position.X >= Size - 1 || Position.Y >= Size - 1) return;
+
+            real32 Sum = *Cell;
+            MortonGridForEachNeighbor(&GridIn, Position, [&](ivec2, real32 *Neighbor) { Sum += *Neighbor; });
+            *MortonGridAt(&GridOut, Position) = Sum * (1.0f / 9.0f);
+        });
+        BenchKeep(*MortonGridAt(&GridOut, ivec2{1, 1}));
+    });
+
+    BenchRun("morton_grid, tile by tile with MortonGridAt", Operations, [&]()
+    {
+        for(int32 TileY = 0;
+            TileY < GridIn.TilesY;
+            ++TileY)
+        {
+            for(int32 TileX = 0;
+                TileX < GridIn.TilesX;
+                ++TileX)
+            {
+                for(int32 LocalY = 0;
+                    LocalY < MORTON_GRID_TILE_SIZE;
+                    ++LocalY)
+                {
+                    int32 Y = (TileY << MORTON_GRID_TILE_SHIFT) + LocalY;
+                    if(Y < 1 || Y >= Size - 1) continue;
+
+                    for(int32 LocalX = 0;
+                        LocalX < MORTON_GRID_TILE_SIZE;
+                        ++LocalX)
+                    {
+                        int32 X = (TileX << MORTON_GRID_TILE_SHIFT) + LocalX;
+                        if(X < 1 || X >= Size - 1) continue;
+
+                        real32 Sum = 0.0f;
+                        for(int32 OffsetY = -1;
+                            OffsetY <= 1;
+                            ++OffsetY)
+                        {
+                            for(int32 OffsetX = -1;
+                                OffsetX <= 1;
+                                ++OffsetX)
+                            {
+                                Sum += *MortonGridAt(&GridIn, ivec2{X + OffsetX, Y + OffsetY});
+                            }
+                        }
+                        *MortonGridAt(&GridOut, ivec2{X, Y}) = Sum * (1.0f / 9.0f);
+                    }
+                }
+            }
+        }
+        BenchKeep(*MortonGridAt(&GridOut, ivec2{1, 1}));
+    });
+
+    EndScratchBlock(&Scratch);
+}
+
+int
+main()
+{
+    memory_arena Arena = InitializeVirtualArena(GB(1));
+
+    int32 Sizes[] = {256, 1024, 4096};
+    for(int32 Size : Sizes)
+    {
+        BenchStencil(Size, &Arena);
+    }
+
+    ReleaseVirtualArena(&Arena);
+    return(0);
+}
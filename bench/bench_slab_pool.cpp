@@ -0,0 +1,93 @@
+/* ========================================================================
+   $File: bench_slab_pool.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "bench.h"
+#include "../arena.h"
+#include "../slab_pool.h"
+
+// NOTE(Sleepster): Keeps LIVE_COUNT objects alive and keeps replacing random ones, so the
+// allocators are measured once their free lists are good and shuffled, not fresh out of the box
+constexpr uint32 LIVE_COUNT  = 1 << 16;
+constexpr uint64 CHURN_COUNT = 1 << 22;
+
+internal void
+BenchChurn(void **Live, uint64 ElementSize, auto Alloc, auto Free)
+{
+    uint64 RandomState = 0x9E3779B97F4A7C15ULL;
+    for(uint64 Index = 0;
+        Index < CHURN_COUNT;
+        ++Index)
+    {
+        uint32 Slot = (uint32)BenchRandom(&RandomState) & (LIVE_COUNT - 1);
+        Free(Live[Slot]);
+
+        uint8 *Element = (uint8 *)Alloc();
+        Element[0]               = (uint8)Index;
+        Element[ElementSize - 1] = (uint8)Index;
+        Live[Slot] = Element;
+    }
+}
+
+internal void
+BenchFill(void **Live, auto Alloc)
+{
+    for(uint32 Slot = 0;
+        Slot < LIVE_COUNT;
+        ++Slot)
+    {
+        Live[Slot] = Alloc();
+    }
+}
+
+int
+main()
+{
+    void **Live = (void **)malloc(LIVE_COUNT * sizeof(void *));
+    memory_arena Arena = InitializeVirtualArena(GB(1));
+
+    for(uint64 ElementSize = 16;
+        ElementSize <= 256;
+        ElementSize *= 2)
+    {
+        char Title[64];
+        snprintf(Title, sizeof(Title), "%llu byte objects, %u live", (unsigned long long)ElementSize, LIVE_COUNT);
+        BenchSection(Title);
+
+        BenchFill(Live, [&]() { return(malloc(ElementSize)); });
+        BenchRun("malloc/free", CHURN_COUNT, [&]()
+        {
+            BenchChurn(Live, ElementSize, [&]() { return(malloc(ElementSize)); }, [](void *Memory) { free(Memory); });
+        });
+        for(uint32 Slot = 0;
+            Slot < LIVE_COUNT;
+            ++Slot)
+        {
+            free(Live[Slot]);
+        }
+
+        ClearArena(&Arena);
+        slab_pool Pool = _SlabPoolCreate(&Arena, ElementSize, 16);
+        BenchFill(Live, [&]() { return(SlabAlloc_(&Pool)); });
+        BenchRun("SlabAlloc_/SlabFree", CHURN_COUNT, [&]()
+        {
+            BenchChurn(Live, ElementSize, [&]() { return(SlabAlloc_(&Pool)); }, [&](void *Memory) { SlabFree(&Pool, Memory); });
+        });
+
+        ClearArena(&Arena);
+        Pool = _SlabPoolCreate(&Arena, ElementSize, 16);
+        slab_cache Cache = InitializeSlabCache(&Pool);
+        BenchFill(Live, [&]() { return(SlabCacheAlloc_(&Cache)); });
+        BenchRun("SlabCacheAlloc_/SlabCacheFree (thread cache)", CHURN_COUNT, [&]()
+        {
+            BenchChurn(Live, ElementSize, [&]() { return(SlabCacheAlloc_(&Cache)); }, [&](void *Memory) { SlabCacheFree(&Cache, Memory); });
+        });
+    }
+
+    ReleaseVirtualArena(&Arena);
+    free(Live);
+    return(0);
+}
@@ -0,0 +1,148 @@
+/* ========================================================================
+   $File: bench_slot_map.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "bench.h"
+#include "../arena.h"
+#include "../list.h"
+#include "../slot_map.h"
+
+// NOTE(Sleepster): The pointer side is what we do today, a list of pointers to objects that
+// were malloc'd one by one. Both sides get churned (half the objects removed and recreated
+// in random order) before they're measured, so the heap objects are as scattered as they'd be
+// after a while in a real program.
+struct bench_object
+{
+    real32 Position[3];
+    real32 Velocity[3];
+    uint32 Id;
+    uint32 Flags;
+};
+
+constexpr uint64 LOOKUP_COUNT = 1 << 22;
+
+internal void
+BenchSlotMap(uint32 Count, memory_arena *Arena)
+{
+    char Title[64];
+    snprintf(Title, sizeof(Title), "%u objects (%llu bytes each)", Count, (unsigned long long)sizeof(bench_object));
+    BenchSection(Title);
+
+    ClearArena(Arena);
+    slot_map<bench_object> Map;
+    InitializeSlotMap(&Map, Arena);
+    slot_handle *Handles = PushArray(Arena, slot_handle, Count);
+
+    list Pointers       = {};
+    Pointers.Stride     = sizeof(bench_object *);
+    Pointers.GrowFactor = LIST_GROW_FACTOR;
+    ListReserve(&Pointers, Count);
+
+    for(uint32 Index = 0;
+        Index < Count;
+        ++Index)
+    {
+        bench_object Object = {};
+        Object.Id = Index;
+
+        Handles[Index] = SlotMapInsert(&Map, Object);
+
+        bench_object *Pointer = (bench_object *)malloc(sizeof(bench_object));
+        *Pointer = Object;
+        ListAppendValue(&Pointers, Pointer);
+    }
+
+    uint64 RandomState = 0x9E3779B97F4A7C15ULL;
+    for(uint32 Churn = 0;
+        Churn < Count / 2;
+        ++Churn)
+    {
+        uint32 Index = (uint32)(BenchRandom(&RandomState) % Count);
+
+        bench_object Object = {};
+        Object.Id = Index;
+
+        SlotMapRemove(&Map, Handles[Index]);
+        Handles[Index] = SlotMapInsert(&Map, Object);
+
+        bench_object **Slot = (bench_object **)ListGetValueAtIndex(&Pointers, (int32)Index);
+        free(*Slot);
+        *Slot = (bench_object *)malloc(sizeof(bench_object));
+        **Slot = Object;
+    }
+
+    BenchRun("iterate, list of pointers", Count, [&]()
+    {
+        bench_object **Objects = (bench_object **)Pointers.Elements;
+        for(uint64 Index = 0;
+            Index < Pointers.Used;
+            ++Index)
+        {
+            Objects[Index]->Position[0] += Objects[Index]->Velocity[0] + 1.0f;
+        }
+        BenchKeep(Objects[0]->Position[0]);
+    });
+
+    BenchRun("iterate, slot_map", Count, [&]()
+    {
+        for(bench_object &Object : Map)
+        {
+            Object.Position[0] += Object.Velocity[0] + 1.0f;
+        }
+        BenchKeep(Map.Dense[0].Position[0]);
+    });
+
+    BenchRun("random lookup, list of pointers", LOOKUP_COUNT, [&]()
+    {
+        bench_object **Objects = (bench_object **)Pointers.Elements;
+        uint64 State = 0xD1B54A32D192ED03ULL;
+        uint64 Sum   = 0;
+        for(uint64 Lookup = 0;
+            Lookup < LOOKUP_COUNT;
+            ++Lookup)
+        {
+            Sum += Objects[BenchRandom(&State) % Count]->Id;
+        }
+        BenchKeep(Sum);
+    });
+
+    BenchRun("random lookup, SlotMapGet", LOOKUP_COUNT, [&]()
+    {
+        uint64 State = 0xD1B54A32D192ED03ULL;
+        uint64 Sum   = 0;
+        for(uint64 Lookup = 0;
+            Lookup < LOOKUP_COUNT;
+            ++Lookup)
+        {
+            Sum += SlotMapGet(&Map, Handles[BenchRandom(&State) % Count])->Id;
+        }
+        BenchKeep(Sum);
+    });
+
+    bench_object **Objects = (bench_object **)Pointers.Elements;
+    for(uint64 Index = 0;
+        Index < Pointers.Used;
+        ++Index)
+    {
+        free(Objects[Index]);
+    }
+    ListFree(Pointers.Elements);
+}
+
+int
+main()
+{
+    memory_arena Arena = InitializeVirtualArena(GB(1));
+
+    uint32 Counts[] = {1 << 12, 1 << 16, 1 << 20};
+    for(uint32 Count : Counts)
+    {
+        BenchSlotMap(Count, &Arena);
+    }
+
+    ReleaseVirtualArena(&Arena);
+    return(0);
+}
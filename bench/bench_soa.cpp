@@ -0,0 +1,108 @@
+/* ========================================================================
+   $File: bench_soa.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "bench.h"
+#include "../arena.h"
+#include "../custom_math.h"
+#include "../soa.h"
+
+// NOTE(Sleepster): The integration only touches Position and Velocity. With the AoS layout
+// every cache line it pulls in is mostly the rest of the entity, with SoA it's all useful.
+#define ENTITY_FIELDS(X)    \
+    X(vec3,   Position)     \
+    X(vec3,   Velocity)     \
+    X(quat,   Rotation)     \
+    X(vec4,   Color)        \
+    X(real32, Mass)         \
+    X(uint32, Flags)
+
+DECLARE_SOA(entities, ENTITY_FIELDS)
+
+// NOTE(Sleepster): DECLARE_SOA already gives us the plain struct for the AoS side
+typedef entities_element entity;
+
+constexpr real32 DELTA_TIME = 1.0f / 60.0f;
+constexpr int32  STEP_COUNT = 16;
+
+internal void
+BenchIntegrate(uint32 Count, memory_arena *Arena)
+{
+    char Title[96];
+    snprintf(Title, sizeof(Title), "%u entities (%llu bytes each), %d steps", Count, (unsigned long long)sizeof(entity), STEP_COUNT);
+    BenchSection(Title);
+
+    scratch_memory Scratch = BeginScratchBlock(Arena);
+
+    entity *AoS = PushArray(Arena, entity, Count, 64);
+    entities SoA;
+    InitializeSoa(&SoA, Arena, Count);
+
+    for(uint32 Index = 0;
+        Index < Count;
+        ++Index)
+    {
+        entity Entity = {};
+        Entity.Position = v3Create((real32)Index, 0.0f, 0.0f);
+        Entity.Velocity = v3Create(1.0f, 2.0f, (real32)(Index & 7));
+        Entity.Mass     = 1.0f;
+
+        AoS[Index] = Entity;
+        SoaPush(&SoA, Entity);
+    }
+
+    uint64 Operations = (uint64)Count * STEP_COUNT;
+    BenchRun("AoS, entity[]", Operations, [&]()
+    {
+        for(int32 Step = 0;
+            Step < STEP_COUNT;
+            ++Step)
+        {
+            for(uint32 Index = 0;
+                Index < Count;
+                ++Index)
+            {
+                AoS[Index].Position += AoS[Index].Velocity * DELTA_TIME;
+            }
+        }
+        BenchKeep(AoS[Count - 1].Position.X);
+    });
+
+    BenchRun("SoA, DECLARE_SOA columns", Operations, [&]()
+    {
+        vec3 *Position = SoA.Position;
+        vec3 *Velocity = SoA.Velocity;
+        for(int32 Step = 0;
+            Step < STEP_COUNT;
+            ++Step)
+        {
+            for(uint32 Index = 0;
+                Index < SoA.Used;
+                ++Index)
+            {
+                Position[Index] += Velocity[Index] * DELTA_TIME;
+            }
+        }
+        BenchKeep(Position[Count - 1].X);
+    });
+
+    EndScratchBlock(&Scratch);
+}
+
+int
+main()
+{
+    memory_arena Arena = InitializeVirtualArena(GB(1));
+
+    uint32 Counts[] = {1 << 12, 1 << 16, 1 << 20, 1 << 22};
+    for(uint32 Count : Counts)
+    {
+        BenchIntegrate(Count, &Arena);
+    }
+
+    ReleaseVirtualArena(&Arena);
+    return(0);
+}
@@ -0,0 +1,116 @@
+/* ========================================================================
+   $File: bench_tlsf.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "bench.h"
+#include "../arena.h"
+#include "../tlsf.h"
+
+// NOTE(Sleepster): Mixed sizes, mostly small with the odd big one, replacing random live
+// allocations. The second pass times every allocation on its own, what we care about with
+// TLSF is the worst case, not the average.
+constexpr uint32 LIVE_COUNT    = 1 << 14;
+constexpr uint64 CHURN_COUNT   = 1 << 21;
+constexpr uint64 LATENCY_COUNT = 1 << 20;
+
+internal inline memory_index
+BenchPickSize(uint64 *RandomState)
+{
+    uint64 Random = BenchRandom(RandomState);
+    if((Random & 63) == 0) return(KB(4) + ((Random >> 8) & (KB(64) - 1)));
+    return(16 + ((Random >> 8) & (KB(1) - 1)));
+}
+
+internal void
+BenchChurn(void **Live, uint64 Count, auto Alloc, auto Free)
+{
+    uint64 RandomState = 0x9E3779B97F4A7C15ULL;
+    for(uint64 Index = 0;
+        Index < Count;
+        ++Index)
+    {
+        uint32 Slot = (uint32)BenchRandom(&RandomState) & (LIVE_COUNT - 1);
+        Free(Live[Slot]);
+
+        uint8 *Memory = (uint8 *)Alloc(BenchPickSize(&RandomState));
+        if(Memory) Memory[0] = (uint8)Index;
+        Live[Slot] = Memory;
+    }
+}
+
+internal int
+BenchCompareLatency(const void *A, const void *B)
+{
+    real64 LatencyA = *(const real64 *)A;
+    real64 LatencyB = *(const real64 *)B;
+    return((LatencyA > LatencyB) - (LatencyA < LatencyB));
+}
+
+internal void
+BenchLatency(const char *Name, void **Live, real64 *Latencies, auto Alloc, auto Free)
+{
+    uint64 RandomState = 0xD1B54A32D192ED03ULL;
+    for(uint64 Index = 0;
+        Index < LATENCY_COUNT;
+        ++Index)
+    {
+        uint32 Slot = (uint32)BenchRandom(&RandomState) & (LIVE_COUNT - 1);
+        memory_index Size = BenchPickSize(&RandomState);
+
+        real64 Start = BenchGetSeconds();
+        Free(Live[Slot]);
+        uint8 *Memory = (uint8 *)Alloc(Size);
+        Latencies[Index] = BenchGetSeconds() - Start;
+
+        if(Memory) Memory[0] = (uint8)Index;
+        Live[Slot] = Memory;
+    }
+
+    qsort(Latencies, LATENCY_COUNT, sizeof(real64), BenchCompareLatency);
+    printf("  %-52s p50 %6.0f ns  p99 %6.0f ns  p99.9 %7.0f ns  max %9.0f ns\n", Name,
+           Latencies[LATENCY_COUNT / 2] * 1e9,
+           Latencies[(LATENCY_COUNT * 99) / 100] * 1e9,
+           Latencies[(LATENCY_COUNT * 999) / 1000] * 1e9,
+           Latencies[LATENCY_COUNT - 1] * 1e9);
+}
+
+int
+main()
+{
+    void  **Live      = (void **)calloc(LIVE_COUNT, sizeof(void *));
+    real64 *Latencies = (real64 *)malloc(LATENCY_COUNT * sizeof(real64));
+
+    memory_pool     Pool = InitializeMemoryPool(MB(512));
+    tlsf_allocator *TLSF = InitializeTLSF(&Pool, MB(512) - KB(64));
+
+    auto MallocAlloc = [](memory_index Size) { return(malloc(Size)); };
+    auto MallocFree  = [](void *Memory) { free(Memory); };
+    auto TLSFAllocFn = [&](memory_index Size) { return(TLSFAlloc(TLSF, Size)); };
+    auto TLSFFreeFn  = [&](void *Memory) { TLSFFree(TLSF, Memory); };
+
+    BenchSection("Churn, 16B-1KB with 1 in 64 between 4KB and 68KB");
+    BenchChurn(Live, LIVE_COUNT, MallocAlloc, MallocFree);
+    BenchRun("malloc/free", CHURN_COUNT, [&]() { BenchChurn(Live, CHURN_COUNT, MallocAlloc, MallocFree); });
+    BenchLatency("malloc/free latency", Live, Latencies, MallocAlloc, MallocFree);
+    for(uint32 Slot = 0;
+        Slot < LIVE_COUNT;
+        ++Slot)
+    {
+        free(Live[Slot]);
+        Live[Slot] = 0;
+    }
+
+    BenchChurn(Live, LIVE_COUNT, TLSFAllocFn, TLSFFreeFn);
+    BenchRun("TLSFAlloc/TLSFFree", CHURN_COUNT, [&]() { BenchChurn(Live, CHURN_COUNT, TLSFAllocFn, TLSFFreeFn); });
+    BenchLatency("TLSFAlloc/TLSFFree latency", Live, Latencies, TLSFAllocFn, TLSFFreeFn);
+
+    TLSFLogStats(TLSF);
+
+    ReleaseMemoryPool(&Pool);
+    free(Latencies);
+    free(Live);
+    return(0);
+}
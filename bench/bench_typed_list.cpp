@@ -0,0 +1,103 @@
+/* ========================================================================
+   $File: bench_typed_list.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include <vector>
+
+#include "bench.h"
+#include "../arena.h"
+#include "../list.h"
+#include "../typed_list.h"
+
+// NOTE(Sleepster): Appends one at a time from empty, so every container pays for all of its
+// growth. The big counts are where typed_list switches over to mremap.
+struct bench_particle
+{
+    real32 Position[3];
+    real32 Velocity[3];
+    real32 Color[4];
+    real32 Lifetime;
+    uint32 Flags;
+};
+
+template <typename type>
+internal void
+BenchAppend(const char *TypeName, uint64 Count)
+{
+    char Title[96];
+    snprintf(Title, sizeof(Title), "%llu x %s (%llu bytes)", (unsigned long long)Count, TypeName, (unsigned long long)sizeof(type));
+    BenchSection(Title);
+
+    type Value = {};
+    BenchRun("std::vector::push_back", Count, [&]()
+    {
+        std::vector<type> Vector;
+        for(uint64 Index = 0;
+            Index < Count;
+            ++Index)
+        {
+            Vector.push_back(Value);
+        }
+        BenchKeep(Vector.data());
+    });
+
+    // NOTE(Sleepster): Built by hand so ListCreate/ListDestroy's trace logging isn't timed,
+    // the first append grows it to DEFAULT_LIST_SIZE like a fresh list
+    BenchRun("ListAppendValue", Count, [&]()
+    {
+        list List       = {};
+        List.Stride     = sizeof(type);
+        List.GrowFactor = LIST_GROW_FACTOR;
+        for(uint64 Index = 0;
+            Index < Count;
+            ++Index)
+        {
+            ListAppendValue(&List, Value);
+        }
+        BenchKeep(List.Elements);
+        ListFree(List.Elements);
+    });
+
+    BenchRun("TypedListAppend", Count, [&]()
+    {
+        typed_list<type> List = TypedListCreate<type>();
+        for(uint64 Index = 0;
+            Index < Count;
+            ++Index)
+        {
+            TypedListAppend(&List, Value);
+        }
+        BenchKeep(List.Elements);
+        TypedListDestroy(&List);
+    });
+
+    BenchRun("TypedListReserve + TypedListAppend", Count, [&]()
+    {
+        typed_list<type> List = TypedListCreate<type>();
+        TypedListReserve(&List, Count);
+        for(uint64 Index = 0;
+            Index < Count;
+            ++Index)
+        {
+            TypedListAppend(&List, Value);
+        }
+        BenchKeep(List.Elements);
+        TypedListDestroy(&List);
+    });
+}
+
+int
+main()
+{
+    uint64 Counts[] = {1 << 10, 1 << 20, 1 << 24};
+    for(uint64 Count : Counts)
+    {
+        BenchAppend<uint64>("uint64", Count);
+        BenchAppend<bench_particle>("bench_particle", Count);
+    }
+
+    return(0);
+}
@@ -0,0 +1,92 @@
+/* ========================================================================
+   $File: bench_zeroing.cpp $
+   $Date: Sat, 17 Oct 26: 11:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "bench.h"
+#include "../arena.h"
+
+// NOTE(Sleepster): Every iteration pushes one big zeroed block and then reads a small hot
+// working set, so the numbers include whatever the zeroing did to the cache, not just the
+// zeroing itself. Each arena is dirtied first so memset/streaming actually have work to do.
+constexpr memory_index HOT_SIZE   = KB(512);
+constexpr uint64       PUSH_COUNT = 64;
+
+internal uint64
+BenchReadHot(uint64 *Hot)
+{
+    uint64 Sum = 0;
+    for(memory_index Index = 0;
+        Index < (HOT_SIZE / sizeof(uint64));
+        Index += 8)
+    {
+        Sum += Hot[Index];
+    }
+
+    return(Sum);
+}
+
+internal void
+BenchZeroing(const char *Name, memory_arena *Arena, memory_index Size, uint64 *Hot, auto PushZero)
+{
+    memset(PushSize_(Arena, Size, 64), 0xCD, Size);
+    ClearArena(Arena);
+
+    BenchRun(Name, PUSH_COUNT, [&]()
+    {
+        for(uint64 Push = 0;
+            Push < PUSH_COUNT;
+            ++Push)
+        {
+            uint8 *Memory = (uint8 *)PushZero(Arena, Size);
+            BenchKeep(Memory[Size / 2]);
+            BenchKeep(BenchReadHot(Hot));
+            ClearArena(Arena);
+        }
+    });
+}
+
+int
+main()
+{
+    uint64 *Hot = (uint64 *)malloc(HOT_SIZE);
+    memset(Hot, 1, HOT_SIZE);
+
+    memory_index Sizes[] = {KB(256), MB(4), MB(64)};
+    for(memory_index Size : Sizes)
+    {
+        char Title[64];
+        snprintf(Title, sizeof(Title), "%llu KB zeroed push + %llu KB hot read", (unsigned long long)(Size / KB(1)), (unsigned long long)(HOT_SIZE / KB(1)));
+        BenchSection(Title);
+
+        memory_pool  Pool  = InitializeMemoryPool(Size + KB(4));
+        memory_arena Fixed = InitializeArena(&Pool, Size + KB(4));
+        BenchZeroing("PushSize_ + memset (old path)", &Fixed, Size, Hot, [](memory_arena *Arena, memory_index PushSize)
+        {
+            void *Result = PushSize_(Arena, PushSize, 64);
+            memset(Result, 0, PushSize);
+            return(Result);
+        });
+
+        BenchZeroing("PushSizeZero_, streaming stores", &Fixed, Size, Hot, [](memory_arena *Arena, memory_index PushSize)
+        {
+            return(PushSizeZero_(Arena, PushSize, 64));
+        });
+
+        // NOTE(Sleepster): Decommitting everything on clear means every push gets fresh zero pages
+        // from the OS, so nothing is written until it's used (and the page faults are paid then)
+        memory_arena Virtual = InitializeVirtualArena(Size + MB(1), PlatformGetPageSize());
+        BenchZeroing("PushSizeZero_, decommitted virtual arena", &Virtual, Size, Hot, [](memory_arena *Arena, memory_index PushSize)
+        {
+            return(PushSizeZero_(Arena, PushSize, 64));
+        });
+
+        ReleaseVirtualArena(&Virtual);
+        free(Pool.MemoryBlock);
+    }
+
+    free(Hot);
+    return(0);
+}
@@ -0,0 +1,345 @@
+#if !defined(BITSET_H)
+/* ========================================================================
+   $File: bitset.h $
+   $Date: Sat, 17 Oct 26: 10:47PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define BITSET_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BITSET_USE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BITSET_USE_SSE2 1
+#endif
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// NOTE(Sleepster): A rank block is 512 bits (8 words), one cache line of the bitset
+constexpr uint64 BITSET_RANK_BLOCK_WORDS = 8;
+constexpr uint64 BITSET_RANK_BLOCK_BITS  = BITSET_RANK_BLOCK_WORDS * 64;
+
+enum bitset_op
+{
+    BITSET_OP_AND,
+    BITSET_OP_OR,
+    BITSET_OP_ANDNOT,
+    BITSET_OP_XOR,
+};
+
+// NOTE(Sleepster): Words is padded out to whole rank blocks and the bits past BitCount are always
+// zero, so the set operations never need a tail loop. RankBlocks[N] is how many bits are set before
+// block N, it's only valid after BitsetBuildRank and goes stale as soon as the bitset is changed.
+struct bitset
+{
+    uint64  BitCount;
+    uint64  WordCount;
+    uint64 *Words;
+
+    uint64 *RankBlocks;
+    bool8   RankIsStale;
+};
+
+internal inline uint32
+BitsetPopCount(uint64 Value)
+{
+#if _MSC_VER
+    return((uint32)__popcnt64(Value));
+#else
+    return((uint32)__builtin_popcountll(Value));
+#endif
+}
+
+internal inline uint32
+BitsetCountTrailingZeros(uint64 Value)
+{
+#if _MSC_VER
+    unsigned long Index;
+    _BitScanForward64(&Index, Value);
+    return((uint32)Index);
+#else
+    return((uint32)__builtin_ctzll(Value));
+#endif
+}
+
+internal bitset
+InitializeBitset(memory_arena *Arena, uint64 BitCount)
+{
+    bitset Result = {};
+
+    uint64 BlockCount = (BitCount + BITSET_RANK_BLOCK_BITS - 1) / BITSET_RANK_BLOCK_BITS;
+    Result.WordCount  = BlockCount * BITSET_RANK_BLOCK_WORDS;
+    Result.Words      = (uint64 *)PushSizeZero_(Arena, Result.WordCount * sizeof(uint64), CACHE_LINE_SIZE);
+    Result.RankBlocks = (uint64 *)PushSizeZero_(Arena, (BlockCount + 1) * sizeof(uint64), 8);
+
+    if(Result.Words && Result.RankBlocks)
+    {
+        Result.BitCount = BitCount;
+    }
+    else
+    {
+        Log(LOG_ERROR, "Failed to push a bitset of '%llu' bits!", (unsigned long long)BitCount);
+        Result = {};
+    }
+
+    return(Result);
+}
+
+internal inline bool32
+BitsetTest(bitset *Bitset, uint64 Index)
+{
+    Assert(Index < Bitset->BitCount, "Bit '%llu' is past the end of the bitset!", (unsigned long long)Index);
+    return((Bitset->Words[Index >> 6] >> (Index & 63)) & 1);
+}
+
+internal inline void
+BitsetSet(bitset *Bitset, uint64 Index)
+{
+    Assert(Index < Bitset->BitCount, "Bit '%llu' is past the end of the bitset!", (unsigned long long)Index);
+    Bitset->Words[Index >> 6] |= (uint64)1 << (Index & 63);
+    Bitset->RankIsStale = true;
+}
+
+internal inline void
+BitsetClear(bitset *Bitset, uint64 Index)
+{
+    Assert(Index < Bitset->BitCount, "Bit '%llu' is past the end of the bitset!", (unsigned long long)Index);
+    Bitset->Words[Index >> 6] &= ~((uint64)1 << (Index & 63));
+    Bitset->RankIsStale = true;
+}
+
+internal inline void
+BitsetToggle(bitset *Bitset, uint64 Index)
+{
+    Assert(Index < Bitset->BitCount, "Bit '%llu' is past the end of the bitset!", (unsigned long long)Index);
+    Bitset->Words[Index >> 6] ^= (uint64)1 << (Index & 63);
+    Bitset->RankIsStale = true;
+}
+
+internal inline void
+BitsetClearAll(bitset *Bitset)
+{
+    memset(Bitset->Words, 0, Bitset->WordCount * sizeof(uint64));
+    Bitset->RankIsStale = true;
+}
+
+// NOTE(Sleepster): Dest = A op B, all three need the same size. Dest can be A or B.
+internal void
+BitsetCombine(bitset *Dest, bitset *A, bitset *B, bitset_op Op)
+{
+    Assert(Dest->WordCount == A->WordCount && A->WordCount == B->WordCount, "Bitsets are different sizes!");
+
+    uint64 *DestWords = Dest->Words;
+    uint64 *AWords    = A->Words;
+    uint64 *BWords    = B->Words;
+    uint64  WordIndex = 0;
+
+#if defined(BITSET_USE_AVX2)
+    for(;
+        WordIndex < Dest->WordCount;
+        WordIndex += 4)
+    {
+        __m256i AValue = _mm256_load_si256((__m256i *)(AWords + WordIndex));
+        __m256i BValue = _mm256_load_si256((__m256i *)(BWords + WordIndex));
+        __m256i Result;
+        switch(Op)
+        {
+            case BITSET_OP_AND:    Result = _mm256_and_si256(AValue, BValue);    break;
+            case BITSET_OP_OR:     Result = _mm256_or_si256(AValue, BValue);     break;
+            case BITSET_OP_ANDNOT: Result = _mm256_andnot_si256(BValue, AValue); break;
+            default:               Result = _mm256_xor_si256(AValue, BValue);    break;
+        }
+        _mm256_store_si256((__m256i *)(DestWords + WordIndex), Result);
+    }
+#elif defined(BITSET_USE_SSE2)
+    for(;
+        WordIndex < Dest->WordCount;
+        WordIndex += 2)
+    {
+        __m128i AValue = _mm_load_si128((__m128i *)(AWords + WordIndex));
+        __m128i BValue = _mm_load_si128((__m128i *)(BWords + WordIndex));
+        __m128i Result;
+        switch(Op)
+        {
+            case BITSET_OP_AND:    Result = _mm_and_si128(AValue, BValue);    break;
+            case BITSET_OP_OR:     Result = _mm_or_si128(AValue, BValue);     break;
+            case BITSET_OP_ANDNOT: Result = _mm_andnot_si128(BValue, AValue); break;
+            default:               Result = _mm_xor_si128(AValue, BValue);    break;
+        }
+        _mm_store_si128((__m128i *)(DestWords + WordIndex), Result);
+    }
+#else
+    for(;
+        WordIndex < Dest->WordCount;
+        ++WordIndex)
+    {
+        switch(Op)
+        {
+            case BITSET_OP_AND:    DestWords[WordIndex] = AWords[WordIndex] &  BWords[WordIndex]; break;
+            case BITSET_OP_OR:     DestWords[WordIndex] = AWords[WordIndex] |  BWords[WordIndex]; break;
+            case BITSET_OP_ANDNOT: DestWords[WordIndex] = AWords[WordIndex] & ~BWords[WordIndex]; break;
+            default:               DestWords[WordIndex] = AWords[WordIndex] ^  BWords[WordIndex]; break;
+        }
+    }
+#endif
+
+    Dest->RankIsStale = true;
+}
+
+internal inline void BitsetAnd(bitset *Dest, bitset *A, bitset *B)    { BitsetCombine(Dest, A, B, BITSET_OP_AND);    }
+internal inline void BitsetOr(bitset *Dest, bitset *A, bitset *B)     { BitsetCombine(Dest, A, B, BITSET_OP_OR);     }
+internal inline void BitsetAndNot(bitset *Dest, bitset *A, bitset *B) { BitsetCombine(Dest, A, B, BITSET_OP_ANDNOT); }
+internal inline void BitsetXor(bitset *Dest, bitset *A, bitset *B)    { BitsetCombine(Dest, A, B, BITSET_OP_XOR);    }
+
+internal uint64
+BitsetCount(bitset *Bitset)
+{
+    uint64 Result = 0;
+    for(uint64 WordIndex = 0;
+        WordIndex < Bitset->WordCount;
+        ++WordIndex)
+    {
+        Result += BitsetPopCount(Bitset->Words[WordIndex]);
+    }
+
+    return(Result);
+}
+
+// NOTE(Sleepster): Index of the first set bit at or after From, BitCount if there isn't one
+internal inline uint64
+BitsetFindNextSet(bitset *Bitset, uint64 From)
+{
+    if(From >= Bitset->BitCount) return(Bitset->BitCount);
+
+    uint64 WordIndex = From >> 6;
+    uint64 Word      = Bitset->Words[WordIndex] & (~(uint64)0 << (From & 63));
+    while(!Word)
+    {
+        if(++WordIndex >= Bitset->WordCount) return(Bitset->BitCount);
+        Word = Bitset->Words[WordIndex];
+    }
+
+    return((WordIndex << 6) + BitsetCountTrailingZeros(Word));
+}
+
+// NOTE(Sleepster): Calls Callback(uint64 Index) for every set bit in order
+internal inline void
+BitsetForEachSet(bitset *Bitset, auto Callback)
+{
+    for(uint64 WordIndex = 0;
+        WordIndex < Bitset->WordCount;
+        ++WordIndex)
+    {
+        for(uint64 Word = Bitset->Words[WordIndex];
+            Word;
+            Word &= Word - 1)
+        {
+            Callback((WordIndex << 6) + BitsetCountTrailingZeros(Word));
+        }
+    }
+}
+
+internal void
+BitsetBuildRank(bitset *Bitset)
+{
+    uint64 BlockCount = Bitset->WordCount / BITSET_RANK_BLOCK_WORDS;
+    uint64 Total      = 0;
+    for(uint64 Block = 0;
+        Block < BlockCount;
+        ++Block)
+    {
+        Bitset->RankBlocks[Block] = Total;
+
+        uint64 *Words = Bitset->Words + (Block * BITSET_RANK_BLOCK_WORDS);
+        for(uint64 WordIndex = 0;
+            WordIndex < BITSET_RANK_BLOCK_WORDS;
+            ++WordIndex)
+        {
+            Total += BitsetPopCount(Words[WordIndex]);
+        }
+    }
+    Bitset->RankBlocks[BlockCount] = Total;
+    Bitset->RankIsStale = false;
+}
+
+// NOTE(Sleepster): How many bits are set before Index, needs BitsetBuildRank
+internal inline uint64
+BitsetRank(bitset *Bitset, uint64 Index)
+{
+    Assert(!Bitset->RankIsStale, "The bitset changed since BitsetBuildRank was called!");
+    if(Index >= Bitset->BitCount) return(Bitset->RankBlocks[Bitset->WordCount / BITSET_RANK_BLOCK_WORDS]);
+
+    uint64 Block     = Index / BITSET_RANK_BLOCK_BITS;
+    uint64 WordIndex = Index >> 6;
+    uint64 Result    = Bitset->RankBlocks[Block];
+    for(uint64 At = Block * BITSET_RANK_BLOCK_WORDS;
+        At < WordIndex;
+        ++At)
+    {
+        Result += BitsetPopCount(Bitset->Words[At]);
+    }
+    Result += BitsetPopCount(Bitset->Words[WordIndex] & (((uint64)1 << (Index & 63)) - 1));
+
+    return(Result);
+}
+
+internal inline uint32
+BitsetSelectInWord(uint64 Word, uint32 Rank)
+{
+#if defined(__BMI2__)
+    return(BitsetCountTrailingZeros(_pdep_u64((uint64)1 << Rank, Word)));
+#else
+    for(uint32 Skip = 0;
+        Skip < Rank;
+        ++Skip)
+    {
+        Word &= Word - 1;
+    }
+    return(BitsetCountTrailingZeros(Word));
+#endif
+}
+
+// NOTE(Sleepster): Index of the Rank'th set bit (counting from 0), BitCount if there aren't that
+// many. Needs BitsetBuildRank. Handy for turning a dense index back into a position in a sparse set.
+internal uint64
+BitsetSelect(bitset *Bitset, uint64 Rank)
+{
+    Assert(!Bitset->RankIsStale, "The bitset changed since BitsetBuildRank was called!");
+
+    uint64 BlockCount = Bitset->WordCount / BITSET_RANK_BLOCK_WORDS;
+    if(Rank >= Bitset->RankBlocks[BlockCount]) return(Bitset->BitCount);
+
+    // NOTE(Sleepster): Last block that starts at or before Rank
+    uint64 Low  = 0;
+    uint64 High = BlockCount;
+    while((High - Low) > 1)
+    {
+        uint64 Middle = (Low + High) / 2;
+        if(Bitset->RankBlocks[Middle] <= Rank) Low  = Middle;
+        else                                   High = Middle;
+    }
+
+    Rank -= Bitset->RankBlocks[Low];
+    for(uint64 WordIndex = Low * BITSET_RANK_BLOCK_WORDS;
+        ;
+        ++WordIndex)
+    {
+        uint64 Word  = Bitset->Words[WordIndex];
+        uint32 Count = BitsetPopCount(Word);
+        if(Rank < Count)
+        {
+            return((WordIndex << 6) + BitsetSelectInWord(Word, (uint32)Rank));
+        }
+        Rank -= Count;
+    }
+}
+
+#endif // BITSET_H
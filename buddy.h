@@ -0,0 +1,276 @@
+#if !defined(BUDDY_H)
+/* ========================================================================
+   $File: buddy.h $
+   $Date: Sat, 17 Oct 26: 03:30PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define BUDDY_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+
+constexpr int32 BUDDY_MAX_ORDER_COUNT = 48;
+constexpr uint8 BUDDY_BLOCK_FREE      = 0x80;
+
+struct buddy_free_block
+{
+    buddy_free_block *Next;
+    buddy_free_block *Prev;
+};
+
+// NOTE(Sleepster): Power of two block allocator. A block of order N is MinBlockSize << N bytes
+// and its buddy is the block next to it that it was split off of, freeing a block merges it
+// back up with its buddy for as long as the buddy is free too. BlockStates has a byte per
+// MinBlockSize of memory holding (Order + 1) for every block that starts there, plus
+// BUDDY_BLOCK_FREE when it's sitting in a free list.
+struct buddy_allocator
+{
+    uint8            *Base;
+    memory_index      Size;
+    memory_index      MinBlockSize;
+    int32             MaxOrder;
+
+    uint8            *BlockStates;
+    buddy_free_block *FreeLists[BUDDY_MAX_ORDER_COUNT];
+};
+
+struct buddy_stats
+{
+    memory_index FreeBytes;
+    memory_index LargestFreeBlock;
+    uint32       FreeBlockCounts[BUDDY_MAX_ORDER_COUNT];
+
+    // NOTE(Sleepster): 0 when all the free memory is one block, approaches 1 as it gets shredded
+    real32       Fragmentation;
+};
+
+internal inline int32
+BuddyLog2(memory_index Value)
+{
+#if _MSC_VER
+    unsigned long Index;
+    _BitScanReverse64(&Index, Value);
+    return((int32)Index);
+#else
+    return(63 - __builtin_clzll(Value));
+#endif
+}
+
+internal inline memory_index
+BuddyBlockSize(buddy_allocator *Allocator, int32 Order)
+{
+    return(Allocator->MinBlockSize << Order);
+}
+
+internal inline memory_index
+BuddyGetLeaf(buddy_allocator *Allocator, void *Block)
+{
+    return(((uint8 *)Block - Allocator->Base) / Allocator->MinBlockSize);
+}
+
+internal void
+BuddyPushFreeBlock(buddy_allocator *Allocator, void *Memory, int32 Order)
+{
+    buddy_free_block *Block = (buddy_free_block *)Memory;
+    Block->Prev = 0;
+    Block->Next = Allocator->FreeLists[Order];
+    if(Block->Next) Block->Next->Prev = Block;
+
+    Allocator->FreeLists[Order] = Block;
+    Allocator->BlockStates[BuddyGetLeaf(Allocator, Block)] = (uint8)(Order + 1) | BUDDY_BLOCK_FREE;
+}
+
+internal void
+BuddyRemoveFreeBlock(buddy_allocator *Allocator, void *Memory, int32 Order)
+{
+    buddy_free_block *Block = (buddy_free_block *)Memory;
+    if(Block->Prev) Block->Prev->Next = Block->Next;
+    else            Allocator->FreeLists[Order] = Block->Next;
+    if(Block->Next) Block->Next->Prev = Block->Prev;
+
+    Allocator->BlockStates[BuddyGetLeaf(Allocator, Block)] = 0;
+}
+
+// NOTE(Sleepster): Carves Size bytes out of the pool for the blocks themselves, the allocator
+// and its block states are pushed in front of them so a power of two Size is managed in full.
+// Anything past the largest power of two that fits in Size is left unused.
+internal buddy_allocator*
+InitializeBuddyAllocator(memory_pool *BlockBuffer, memory_index Size, memory_index MinBlockSize = KB(4))
+{
+    Assert((MinBlockSize & (MinBlockSize - 1)) == 0, "MinBlockSize has to be a power of two!");
+    if(MinBlockSize < sizeof(buddy_free_block)) MinBlockSize = sizeof(buddy_free_block);
+    if(Size < MinBlockSize)
+    {
+        Log(LOG_ERROR, "Buddy allocator needs at least '%llu' bytes!", (unsigned long long)MinBlockSize);
+        return(0);
+    }
+
+    int32 MaxOrder = BuddyLog2(Size / MinBlockSize);
+    if(MaxOrder >= BUDDY_MAX_ORDER_COUNT) MaxOrder = BUDDY_MAX_ORDER_COUNT - 1;
+
+    memory_index LeafCount = (memory_index)1 << MaxOrder;
+    uint8 *Memory  = BlockBuffer->BlockOffset;
+    uint8 *Header  = Memory + GetAlignmentOffsetForAddress((memory_index)Memory, alignof(buddy_allocator));
+    uint8 *Base    = Header + sizeof(buddy_allocator) + LeafCount;
+    Base += GetAlignmentOffsetForAddress((memory_index)Base, MinBlockSize);
+
+    if((memory_index)((Base + Size) - (uint8 *)BlockBuffer->MemoryBlock) > BlockBuffer->BlockSize)
+    {
+        Log(LOG_ERROR, "Memory pool doesn't have room for a '%llu' byte buddy allocator!", (unsigned long long)Size);
+        return(0);
+    }
+    BlockBuffer->BlockOffset = Base + Size;
+
+    buddy_allocator *Allocator = (buddy_allocator *)Header;
+    memset(Allocator, 0, sizeof(buddy_allocator));
+    Allocator->Base         = Base;
+    Allocator->MinBlockSize = MinBlockSize;
+    Allocator->MaxOrder     = MaxOrder;
+    Allocator->Size         = BuddyBlockSize(Allocator, MaxOrder);
+    Allocator->BlockStates  = (uint8 *)(Allocator + 1);
+    memset(Allocator->BlockStates, 0, LeafCount);
+
+    BuddyPushFreeBlock(Allocator, Allocator->Base, Allocator->MaxOrder);
+
+    Log(LOG_INFO, "Buddy allocator initialized managing '%llu' bytes in blocks of '%llu' to '%llu' bytes",
+        (unsigned long long)Allocator->Size, (unsigned long long)MinBlockSize, (unsigned long long)Allocator->Size);
+    return(Allocator);
+}
+
+internal void*
+BuddyAlloc(buddy_allocator *Allocator, memory_index Size)
+{
+    if(!Size || Size > Allocator->Size) return(0);
+
+    int32 Order = 0;
+    while(BuddyBlockSize(Allocator, Order) < Size) ++Order;
+
+    int32 FoundOrder = Order;
+    while(FoundOrder <= Allocator->MaxOrder && !Allocator->FreeLists[FoundOrder]) ++FoundOrder;
+
+    if(FoundOrder > Allocator->MaxOrder)
+    {
+        Log(LOG_ERROR, "Buddy allocator has no free block of '%llu' bytes!", (unsigned long long)BuddyBlockSize(Allocator, Order));
+        return(0);
+    }
+
+    uint8 *Block = (uint8 *)Allocator->FreeLists[FoundOrder];
+    BuddyRemoveFreeBlock(Allocator, Block, FoundOrder);
+
+    // NOTE(Sleepster): Split it in half until it's the size we want, the upper halves go back as free blocks
+    while(FoundOrder > Order)
+    {
+        --FoundOrder;
+        BuddyPushFreeBlock(Allocator, Block + BuddyBlockSize(Allocator, FoundOrder), FoundOrder);
+    }
+
+    Allocator->BlockStates[BuddyGetLeaf(Allocator, Block)] = (uint8)(Order + 1);
+    return(Block);
+}
+
+internal inline memory_index
+BuddyGetAllocationSize(buddy_allocator *Allocator, void *Memory)
+{
+    uint8 State = Allocator->BlockStates[BuddyGetLeaf(Allocator, Memory)];
+    Assert(State && !(State & BUDDY_BLOCK_FREE), "Pointer is not an allocated buddy block!");
+
+    return(BuddyBlockSize(Allocator, (State & ~BUDDY_BLOCK_FREE) - 1));
+}
+
+internal void
+BuddyFree(buddy_allocator *Allocator, void *Memory)
+{
+    if(!Memory) return;
+
+    memory_index Leaf  = BuddyGetLeaf(Allocator, Memory);
+    uint8        State = Allocator->BlockStates[Leaf];
+    Assert(State && !(State & BUDDY_BLOCK_FREE), "Pointer is not an allocated buddy block, double free?");
+
+    int32 Order = State - 1;
+    Allocator->BlockStates[Leaf] = 0;
+
+    while(Order < Allocator->MaxOrder)
+    {
+        memory_index BuddyLeaf = Leaf ^ ((memory_index)1 << Order);
+        if(Allocator->BlockStates[BuddyLeaf] != ((uint8)(Order + 1) | BUDDY_BLOCK_FREE)) break;
+
+        BuddyRemoveFreeBlock(Allocator, Allocator->Base + (BuddyLeaf * Allocator->MinBlockSize), Order);
+        if(BuddyLeaf < Leaf) Leaf = BuddyLeaf;
+        ++Order;
+    }
+
+    BuddyPushFreeBlock(Allocator, Allocator->Base + (Leaf * Allocator->MinBlockSize), Order);
+}
+
+// NOTE(Sleepster): Arenas that can be handed back to the allocator once you're done with them
+internal inline memory_arena
+InitializeBuddyArena(buddy_allocator *Allocator, memory_index Capacity)
+{
+    memory_arena Arena = {};
+    Arena.Base = (uint8 *)BuddyAlloc(Allocator, Capacity);
+    if(Arena.Base)
+    {
+        Arena.Capacity = BuddyGetAllocationSize(Allocator, Arena.Base);
+    }
+
+    return(Arena);
+}
+
+internal inline void
+ReleaseBuddyArena(buddy_allocator *Allocator, memory_arena *Arena)
+{
+    BuddyFree(Allocator, Arena->Base);
+    *Arena = {};
+}
+
+internal buddy_stats
+BuddyGetStats(buddy_allocator *Allocator)
+{
+    buddy_stats Result = {};
+    for(int32 Order = 0;
+        Order <= Allocator->MaxOrder;
+        ++Order)
+    {
+        for(buddy_free_block *Block = Allocator->FreeLists[Order];
+            Block;
+            Block = Block->Next)
+        {
+            ++Result.FreeBlockCounts[Order];
+        }
+
+        memory_index BlockSize = BuddyBlockSize(Allocator, Order);
+        Result.FreeBytes += Result.FreeBlockCounts[Order] * BlockSize;
+        if(Result.FreeBlockCounts[Order]) Result.LargestFreeBlock = BlockSize;
+    }
+
+    if(Result.FreeBytes)
+    {
+        Result.Fragmentation = 1.0f - ((real32)Result.LargestFreeBlock / (real32)Result.FreeBytes);
+    }
+
+    return(Result);
+}
+
+internal void
+BuddyLogStats(buddy_allocator *Allocator)
+{
+    buddy_stats Stats = BuddyGetStats(Allocator);
+    Log(LOG_INFO, "Buddy: free '%llu' of '%llu' bytes, largest free '%llu', fragmentation %.2f%%",
+        (unsigned long long)Stats.FreeBytes, (unsigned long long)Allocator->Size,
+        (unsigned long long)Stats.LargestFreeBlock, Stats.Fragmentation * 100.0f);
+
+    for(int32 Order = 0;
+        Order <= Allocator->MaxOrder;
+        ++Order)
+    {
+        if(Stats.FreeBlockCounts[Order])
+        {
+            Log(LOG_INFO, "    '%llu' byte blocks free: %u",
+                (unsigned long long)BuddyBlockSize(Allocator, Order), Stats.FreeBlockCounts[Order]);
+        }
+    }
+}
+
+#endif // BUDDY_H
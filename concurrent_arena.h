@@ -0,0 +1,129 @@
+#if !defined(CONCURRENT_ARENA_H)
+/* ========================================================================
+   $File: concurrent_arena.h $
+   $Date: Sat, 17 Oct 26: 10:20AM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define CONCURRENT_ARENA_H
+#include "types.h"
+#include "defines.h"
+#include "debug.h"
+#include "arena.h"
+
+#if !defined(CONCURRENT_ARENA_CHUNK_SIZE)
+#define CONCURRENT_ARENA_CHUNK_SIZE KB(16)
+#endif
+
+// NOTE(Sleepster): Bump allocator that any number of threads can push into at once.
+// Used sits on its own cache line so the threads only fight over that one line,
+// and even that is mostly avoided by going through a concurrent_arena_cache.
+struct concurrent_arena
+{
+    uint8        *Base;
+    memory_index  Capacity;
+    memory_index  ChunkSize;
+
+    alignas(64) volatile uint64 Used;
+    uint8 Padding[64 - sizeof(uint64)];
+};
+
+// NOTE(Sleepster): One of these per thread. It grabs ChunkSize bytes from the shared
+// arena at a time and bumps through them without touching the shared Used.
+struct concurrent_arena_cache
+{
+    concurrent_arena *Shared;
+    memory_arena      Chunk;
+};
+
+#define ConcurrentPushSize(Arena, size, ...)                 ConcurrentPushSize_(Arena, size * sizeof(uint8), ##__VA_ARGS__)
+#define ConcurrentPushStruct(Arena, type, ...)       (type *)ConcurrentPushSize_(Arena, sizeof(type), ##__VA_ARGS__)
+#define ConcurrentPushArray(Arena, type, Count, ...) (type *)ConcurrentPushSize_(Arena, sizeof(type) * (Count), ##__VA_ARGS__)
+
+#define CachedPushSize(Cache, size, ...)                 CachedPushSize_(Cache, size * sizeof(uint8), ##__VA_ARGS__)
+#define CachedPushStruct(Cache, type, ...)       (type *)CachedPushSize_(Cache, sizeof(type), ##__VA_ARGS__)
+#define CachedPushArray(Cache, type, Count, ...) (type *)CachedPushSize_(Cache, sizeof(type) * (Count), ##__VA_ARGS__)
+
+internal inline concurrent_arena
+InitializeConcurrentArena(memory_pool *BlockBuffer, memory_index Capacity, memory_index ChunkSize = CONCURRENT_ARENA_CHUNK_SIZE)
+{
+    concurrent_arena Arena = {};
+    Arena.Base      = (uint8 *)BlockBuffer->BlockOffset;
+    Arena.Capacity  = Capacity;
+    Arena.ChunkSize = ChunkSize;
+    Arena.Used      = 0;
+
+    BlockBuffer->BlockOffset += Capacity;
+    return(Arena);
+}
+
+// NOTE(Sleepster): We don't know where our offset lands until the add has happened, so we
+// reserve the worst case (Size + Alignment - 1) and align inside of whatever we got back.
+// That keeps it to a single fetch-add no matter how many threads are pushing.
+internal void*
+ConcurrentPushSize_(concurrent_arena *Arena, memory_index Size, memory_index Alignment = 4)
+{
+    memory_index Reserved = Size + (Alignment - 1);
+    memory_index Offset   = AtomicAddU64(&Arena->Used, Reserved);
+
+    if((Offset + Reserved) > Arena->Capacity)
+    {
+        Assert(false, "Concurrent arena allocation would exceed the capacity!");
+        Log(LOG_ERROR, "Concurrent arena allocation of '%llu' bytes would exceed the capacity!", (unsigned long long)Size);
+        return(0);
+    }
+
+    uint8 *Result = Arena->Base + Offset;
+    Result += GetAlignmentOffsetForAddress((memory_index)Result, Alignment);
+
+    return(Result);
+}
+
+internal inline concurrent_arena_cache
+InitializeConcurrentArenaCache(concurrent_arena *Shared)
+{
+    concurrent_arena_cache Result = {};
+    Result.Shared = Shared;
+
+    return(Result);
+}
+
+internal void*
+CachedPushSize_(concurrent_arena_cache *Cache, memory_index Size, memory_index Alignment = 4)
+{
+    memory_arena     *Chunk  = &Cache->Chunk;
+    concurrent_arena *Shared = Cache->Shared;
+
+    if((Chunk->Used + GetAlignmentOffset(Chunk, Alignment) + Size) > Chunk->Capacity)
+    {
+        // NOTE(Sleepster): Big pushes would waste most of a chunk, just send them straight through
+        if((Size + Alignment) > (Shared->ChunkSize / 2))
+        {
+            return(ConcurrentPushSize_(Shared, Size, Alignment));
+        }
+
+        // NOTE(Sleepster): Chunks start on a cache line so two threads never write the same one
+        Chunk->Base     = (uint8 *)ConcurrentPushSize_(Shared, Shared->ChunkSize, 64);
+        Chunk->Capacity = Chunk->Base ? Shared->ChunkSize : 0;
+        Chunk->Used     = 0;
+        if(!Chunk->Base) return(0);
+    }
+
+    return(PushSize_(Chunk, Size, Alignment));
+}
+
+// NOTE(Sleepster): Neither of these are thread safe, every thread has to be done pushing
+internal inline void
+ResetConcurrentArenaCache(concurrent_arena_cache *Cache)
+{
+    Cache->Chunk = {};
+}
+
+internal inline void
+ClearConcurrentArena(concurrent_arena *Arena)
+{
+    Arena->Used = 0;
+}
+
+#endif // CONCURRENT_ARENA_H
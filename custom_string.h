@@ -10,6 +10,7 @@
 
 #include "types.h"
 #include "arena.h"
+#include "scratch_arena.h"
 
 #include <stdio.h>
 #include <stdarg.h>
@@ -103,7 +104,7 @@ CStringToString(const char *CString)
 internal inline char *
 StringToCString(memory_arena *Memory, const string String)
 {
-    char *CString = (char *)PushSize(Memory, sizeof(String.Data + 1));
+    char *CString = (char *)PushSize(Memory, String.Length + 1);
     memcpy(CString, String.Data, String.Length);
     CString[String.Length] = 0;
     
@@ -240,8 +241,13 @@ SprintCStringArgsToBuffer(const char *fmt, va_list args, void *Buffer, uint64 Bu
 internal string
 SprintVAList(memory_arena *Memory, const string fmt, va_list args)
 {
-    char *fmt_cstring = StringToCString(Memory, fmt);
-    uint64 Count = FormatStringToBuffer(NULL, 0, fmt_cstring, args) + 1;
+    // NOTE(Sleepster): The null terminated format only lives for this call, keep it off of Memory
+    scratch_scope Scratch = GetScratch(Memory);
+    char *fmt_cstring = StringToCString(Scratch.Arena, fmt);
+    va_list CountArgs;
+    va_copy(CountArgs, args);
+    uint64 Count = FormatStringToBuffer(NULL, 0, fmt_cstring, CountArgs) + 1;
+    va_end(CountArgs);
     
     char* Buffer = {};
     Buffer = (char *)PushSize(Memory, Count);
@@ -7,6 +7,7 @@
    ======================================================================== */
 
 #define DEFINES_H
+#include "types.h"
 
 #define ArrayCount(Array) (sizeof(Array) / sizeof(Array[0]))
 
@@ -22,9 +23,44 @@
 #include <intrin.h>
 inline int32 AtomicCompareExchange32(int32 volatile *Target, int32 Expected, int32 Value)
 {
-    int32 Result = _InterlockedCompareExchange((long *)Target, Expected, Value);
+    int32 Result = _InterlockedCompareExchange((long *)Target, Value, Expected);
     return(Result);
 }
+
+// NOTE(Sleepster): Returns the value *before* the add
+inline uint64 AtomicAddU64(uint64 volatile *Target, uint64 Addend)
+{
+    uint64 Result = _InterlockedExchangeAdd64((__int64 volatile *)Target, Addend);
+    return(Result);
+}
+
+// NOTE(Sleepster): Aligned volatile loads/stores are acquire/release on x64 (/volatile:ms),
+// the barrier just keeps the compiler from moving things across them
+inline uint32 AtomicLoadAcquire32(uint32 volatile *Target)
+{
+    uint32 Result = *Target;
+    _ReadWriteBarrier();
+    return(Result);
+}
+
+inline void AtomicStoreRelease32(uint32 volatile *Target, uint32 Value)
+{
+    _ReadWriteBarrier();
+    *Target = Value;
+}
+
+inline void *AtomicLoadAcquirePointer(void *volatile *Target)
+{
+    void *Result = *Target;
+    _ReadWriteBarrier();
+    return(Result);
+}
+
+inline void AtomicStoreReleasePointer(void *volatile *Target, void *Value)
+{
+    _ReadWriteBarrier();
+    *Target = Value;
+}
 #else
 #define alignas(x)       alignas(x)
 #define inline           inline
@@ -32,6 +68,39 @@ inline int32 AtomicCompareExchange32(int32 volatile *Target, int32 Expected, int
 #define WriteBarrier     __atomic_signal_fence(__ATOMIC_RELEASE); __atomic_thread_fence(__ATOMIC_RELEASE)
 #define ReadBarrier      __atomic_signal_fence(__ATOMIC_ACQUIRE); __atomic_thread_fence(__ATOMIC_ACQUIRE)
 #define ReadWriteBarrier __atomic_signal_fence(__ATOMIC_ACQ_REL); __atomic_thread_fence(__ATOMIC_ACQ_REL)
+
+inline int32 AtomicCompareExchange32(int32 volatile *Target, int32 Expected, int32 Value)
+{
+    __atomic_compare_exchange_n(Target, &Expected, Value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return(Expected);
+}
+
+// NOTE(Sleepster): Returns the value *before* the add
+inline uint64 AtomicAddU64(uint64 volatile *Target, uint64 Addend)
+{
+    uint64 Result = __atomic_fetch_add(Target, Addend, __ATOMIC_SEQ_CST);
+    return(Result);
+}
+
+inline uint32 AtomicLoadAcquire32(uint32 volatile *Target)
+{
+    return(__atomic_load_n(Target, __ATOMIC_ACQUIRE));
+}
+
+inline void AtomicStoreRelease32(uint32 volatile *Target, uint32 Value)
+{
+    __atomic_store_n(Target, Value, __ATOMIC_RELEASE);
+}
+
+inline void *AtomicLoadAcquirePointer(void *volatile *Target)
+{
+    return(__atomic_load_n(Target, __ATOMIC_ACQUIRE));
+}
+
+inline void AtomicStoreReleasePointer(void *volatile *Target, void *Value)
+{
+    __atomic_store_n(Target, Value, __ATOMIC_RELEASE);
+}
 #endif
 
 #endif
@@ -47,8 +47,8 @@ ReadEntireFile(string Filepath, uint32 Size, char *Buffer)
     FILE *File = fopen((const char *)Filepath.Data, "rb");
     if(File)
     {
-        memset(Buffer, 0, Size + 1);
-        fread(Buffer, sizeof(char), Size, File);
+        size_t BytesRead = fread(Buffer, sizeof(char), Size, File);
+        Buffer[BytesRead] = 0;
 
         fclose(File);
     }
@@ -68,10 +68,9 @@ ReadEntireFileMA(memory_arena *ArenaAllocator, string Filepath)
     
     if(FileSize)
     {
+        // NOTE(Sleepster): fread overwrites all of it and terminates it, no need to zero it first
         char *Buffer = (char *)PushSize(ArenaAllocator, uint64(FileSize + 1));
-        memset(Buffer, 0, FileSize + 1);
         File.Data = (uint8 *)ReadEntireFile(Filepath, FileSize, Buffer);
-        File.Data[FileSize + 1] = 0;
         File.Length = FileSize;
     }
     else
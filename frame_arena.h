@@ -0,0 +1,124 @@
+#if !defined(FRAME_ARENA_H)
+/* ========================================================================
+   $File: frame_arena.h $
+   $Date: Sat, 17 Oct 26: 02:47PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define FRAME_ARENA_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+
+constexpr uint32 FRAME_ARENA_MAX_FRAMES = 8;
+
+// NOTE(Sleepster): Ring buffer for memory that has to live for exactly FramesInFlight frames.
+// Head and Tail only ever count up, the ring offset is them modulo Capacity. Starting a new
+// frame retires the oldest one and moves Tail up to the start of the oldest frame still in
+// flight, so nothing ever has to be cleared by hand.
+struct frame_arena
+{
+    uint8        *Base;
+    memory_index  Capacity;
+
+    uint64        Head;
+    uint64        Tail;
+
+    uint64        FrameIndex;
+    uint32        FramesInFlight;
+    uint64        FrameStarts[FRAME_ARENA_MAX_FRAMES];
+};
+
+#define FramePushSize(Arena, size, ...)                 FramePushSize_(Arena, size * sizeof(uint8), ##__VA_ARGS__)
+#define FramePushStruct(Arena, type, ...)       (type *)FramePushSize_(Arena, sizeof(type), ##__VA_ARGS__)
+#define FramePushArray(Arena, type, Count, ...) (type *)FramePushSize_(Arena, sizeof(type) * (Count), ##__VA_ARGS__)
+
+internal inline frame_arena
+InitializeFrameArena(memory_arena *Arena, memory_index Capacity, uint32 FramesInFlight)
+{
+    Assert(FramesInFlight > 0 && FramesInFlight <= FRAME_ARENA_MAX_FRAMES, "FramesInFlight must be between 1 and %u", FRAME_ARENA_MAX_FRAMES);
+
+    frame_arena Result    = {};
+    Result.Base           = (uint8 *)PushSize_(Arena, Capacity, 64);
+    Result.Capacity       = Result.Base ? Capacity : 0;
+    Result.FramesInFlight = FramesInFlight;
+
+    return(Result);
+}
+
+// NOTE(Sleepster): Call once the oldest frame is really done (i.e. after waiting on its fence).
+// In debug builds the retired memory gets stomped so anything still holding onto it shows up.
+internal void
+FrameArenaBeginFrame(frame_arena *Arena)
+{
+    if(!Arena->FramesInFlight) return;
+
+    ++Arena->FrameIndex;
+    Arena->FrameStarts[Arena->FrameIndex % Arena->FramesInFlight] = Arena->Head;
+
+    uint64 OldTail = Arena->Tail;
+    if(Arena->FrameIndex >= Arena->FramesInFlight)
+    {
+        Arena->Tail = Arena->FrameStarts[(Arena->FrameIndex + 1) % Arena->FramesInFlight];
+    }
+
+#if defined(INTERNAL_DEBUG)
+    for(uint64 Position = OldTail;
+        Position < Arena->Tail;)
+    {
+        memory_index Offset = Position % Arena->Capacity;
+        memory_index Length = Arena->Capacity - Offset;
+        if(Length > (Arena->Tail - Position)) Length = Arena->Tail - Position;
+
+        memset(Arena->Base + Offset, 0xCD, Length);
+        Position += Length;
+    }
+#else
+    (void)OldTail;
+#endif
+}
+
+internal void*
+FramePushSize_(frame_arena *Arena, memory_index Size, memory_index Alignment = 4)
+{
+    // NOTE(Sleepster): InitializeFrameArena leaves Capacity at 0 when it couldn't get the memory
+    if(!Arena->Capacity)
+    {
+        Log(LOG_ERROR, "Frame arena has no memory, failed to push '%llu' bytes", (unsigned long long)Size);
+        return(0);
+    }
+
+    uint64       NewHead = Arena->Head;
+    memory_index Offset  = NewHead % Arena->Capacity;
+    memory_index AlignmentOffset = GetAlignmentOffsetForAddress((memory_index)(Arena->Base + Offset), Alignment);
+
+    // NOTE(Sleepster): Allocations never straddle the end of the ring, skip to the start instead
+    if((Offset + AlignmentOffset + Size) > Arena->Capacity)
+    {
+        NewHead += Arena->Capacity - Offset;
+        Offset   = 0;
+        AlignmentOffset = GetAlignmentOffsetForAddress((memory_index)Arena->Base, Alignment);
+    }
+    NewHead += AlignmentOffset + Size;
+
+    if((NewHead - Arena->Tail) > Arena->Capacity)
+    {
+        Assert(false, "Frame %llu overran into memory that is still in flight!", (unsigned long long)Arena->FrameIndex);
+        Log(LOG_ERROR, "Frame %llu overran into memory that is still in flight! Failed to push '%llu' bytes",
+            (unsigned long long)Arena->FrameIndex, (unsigned long long)Size);
+        return(0);
+    }
+
+    Arena->Head = NewHead;
+    return(Arena->Base + Offset + AlignmentOffset);
+}
+
+// NOTE(Sleepster): How many bytes the frames in flight (including this one) are holding onto
+internal inline memory_index
+FrameArenaGetInFlightSize(frame_arena *Arena)
+{
+    return((memory_index)(Arena->Head - Arena->Tail));
+}
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,408 @@
+#if !defined(HASH_MAP_H)
+/* ========================================================================
+   $File: hash_map.h $
+   $Date: Sat, 17 Oct 26: 08:58PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define HASH_MAP_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+#include "custom_string.h"
+
+#pragma push_macro("internal")
+#undef internal
+#include <type_traits>
+#pragma pop_macro("internal")
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASH_MAP_USE_SSE2 1
+#endif
+
+constexpr uint8  HASH_MAP_EMPTY       = 0x80;
+constexpr uint8  HASH_MAP_DELETED     = 0xFE;
+constexpr uint32 HASH_MAP_GROUP_SIZE  = 16;
+
+template <typename key, typename value>
+struct hash_map_slot
+{
+    key   Key;
+    value Value;
+};
+
+// NOTE(Sleepster): Open addressing "swiss table". Every slot has a control byte that is either
+// EMPTY, DELETED, or the low 7 bits of the key's hash, and lookups check 16 control bytes at a
+// time so most misses never touch a key. Probing walks whole 16 slot groups and stops at the
+// first group that has an EMPTY in it. Storage comes from Arena when there is one (old tables
+// are left behind in it when the map grows), otherwise from the heap.
+template <typename key, typename value>
+struct hash_map
+{
+    static_assert(std::is_trivially_copyable<key>::value && std::is_trivially_copyable<value>::value,
+                  "hash_map moves its keys and values around with memcpy");
+
+    uint64                      Capacity;
+    uint64                      Count;
+    uint64                      GrowthLeft;
+    memory_arena               *Arena;
+
+    uint8                      *Control;
+    hash_map_slot<key, value>  *Slots;
+};
+
+internal inline uint64
+HashMapMix(uint64 Value)
+{
+    Value ^= Value >> 33;
+    Value *= 0xFF51AFD7ED558CCDULL;
+    Value ^= Value >> 33;
+    Value *= 0xC4CEB9FE1A85EC53ULL;
+    Value ^= Value >> 33;
+    return(Value);
+}
+
+internal inline uint64
+HashMapHashBytes(const void *Data, uint64 Length)
+{
+    const uint8 *At = (const uint8 *)Data;
+    uint64 Result   = Length * 0x9E3779B97F4A7C15ULL;
+
+    for(;
+        Length >= 8;
+        Length -= 8, At += 8)
+    {
+        uint64 Word;
+        memcpy(&Word, At, 8);
+        Result = (Result ^ Word) * 0x9E3779B97F4A7C15ULL;
+        Result = (Result << 31) | (Result >> 33);
+    }
+
+    uint64 Tail = 0;
+    memcpy(&Tail, At, Length);
+    Result ^= Tail;
+
+    return(HashMapMix(Result));
+}
+
+template <typename key>
+internal inline uint64
+HashMapHash(const key &Key)
+{
+    if constexpr(std::is_integral<key>::value || std::is_enum<key>::value || std::is_pointer<key>::value)
+    {
+        return(HashMapMix((uint64)Key));
+    }
+    else
+    {
+        return(HashMapHashBytes(&Key, sizeof(key)));
+    }
+}
+
+internal inline uint64
+HashMapHash(const string &Key)
+{
+    return(HashMapHashBytes(Key.Data, Key.Length));
+}
+
+template <typename key>
+internal inline bool32
+HashMapKeysMatch(const key &A, const key &B)
+{
+    if constexpr(std::is_scalar<key>::value)
+    {
+        return(A == B);
+    }
+    else
+    {
+        return(memcmp(&A, &B, sizeof(key)) == 0);
+    }
+}
+
+// NOTE(Sleepster): String keys only store the string, the bytes have to outlive the map
+internal inline bool32
+HashMapKeysMatch(const string &A, const string &B)
+{
+    return(StringsMatch(A, B));
+}
+
+internal inline uint32
+HashMapCountTrailingZeros(uint32 Value)
+{
+#if _MSC_VER
+    unsigned long Index;
+    _BitScanForward(&Index, Value);
+    return((uint32)Index);
+#else
+    return(__builtin_ctz(Value));
+#endif
+}
+
+// NOTE(Sleepster): Bit N is set when control byte N of the group is Byte
+internal inline uint32
+HashMapMatchByte(uint8 *Group, uint8 Byte)
+{
+#if defined(HASH_MAP_USE_SSE2)
+    __m128i Control = _mm_loadu_si128((__m128i *)Group);
+    return((uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(Control, _mm_set1_epi8((char)Byte))));
+#else
+    uint32 Result = 0;
+    for(uint32 Index = 0;
+        Index < HASH_MAP_GROUP_SIZE;
+        ++Index)
+    {
+        if(Group[Index] == Byte) Result |= 1 << Index;
+    }
+    return(Result);
+#endif
+}
+
+// NOTE(Sleepster): EMPTY and DELETED are the only control bytes with the top bit set
+internal inline uint32
+HashMapMatchFree(uint8 *Group)
+{
+#if defined(HASH_MAP_USE_SSE2)
+    return((uint32)_mm_movemask_epi8(_mm_loadu_si128((__m128i *)Group)));
+#else
+    uint32 Result = 0;
+    for(uint32 Index = 0;
+        Index < HASH_MAP_GROUP_SIZE;
+        ++Index)
+    {
+        if(Group[Index] & 0x80) Result |= 1 << Index;
+    }
+    return(Result);
+#endif
+}
+
+internal inline uint64
+HashMapGetMaxLoad(uint64 Capacity)
+{
+    return(Capacity - (Capacity / 8));
+}
+
+template <typename key, typename value>
+internal void
+InitializeHashMap(hash_map<key, value> *Map, memory_arena *Arena = 0)
+{
+    *Map = {};
+    Map->Arena = Arena;
+}
+
+template <typename key, typename value>
+internal inline hash_map_slot<key, value>*
+HashMapFindSlot(hash_map<key, value> *Map, const key &Key, uint64 Hash)
+{
+    if(!Map->Capacity) return(0);
+
+    uint8  H2        = (uint8)(Hash & 0x7F);
+    uint64 GroupMask = (Map->Capacity / HASH_MAP_GROUP_SIZE) - 1;
+    uint64 GroupIndex = (Hash >> 7) & GroupMask;
+
+    for(uint64 Step = 0;
+        Step <= GroupMask;
+        ++Step)
+    {
+        uint8 *Group = Map->Control + (GroupIndex * HASH_MAP_GROUP_SIZE);
+        for(uint32 Matches = HashMapMatchByte(Group, H2);
+            Matches;
+            Matches &= Matches - 1)
+        {
+            hash_map_slot<key, value> *Slot = Map->Slots + (GroupIndex * HASH_MAP_GROUP_SIZE) + HashMapCountTrailingZeros(Matches);
+            if(HashMapKeysMatch(Slot->Key, Key)) return(Slot);
+        }
+        if(HashMapMatchByte(Group, HASH_MAP_EMPTY)) return(0);
+
+        GroupIndex = (GroupIndex + Step + 1) & GroupMask;
+    }
+
+    return(0);
+}
+
+// NOTE(Sleepster): First EMPTY or DELETED slot along Hash's probe sequence, the key must not be in the map
+template <typename key, typename value>
+internal inline uint64
+HashMapFindFreeSlot(hash_map<key, value> *Map, uint64 Hash)
+{
+    uint64 GroupMask  = (Map->Capacity / HASH_MAP_GROUP_SIZE) - 1;
+    uint64 GroupIndex = (Hash >> 7) & GroupMask;
+
+    for(uint64 Step = 0;
+        Step <= GroupMask;
+        ++Step)
+    {
+        uint32 Free = HashMapMatchFree(Map->Control + (GroupIndex * HASH_MAP_GROUP_SIZE));
+        if(Free)
+        {
+            return((GroupIndex * HASH_MAP_GROUP_SIZE) + HashMapCountTrailingZeros(Free));
+        }
+
+        GroupIndex = (GroupIndex + Step + 1) & GroupMask;
+    }
+
+    Assert(false, "Hash map has no free slots, this should never happen!");
+    return(0);
+}
+
+template <typename key, typename value>
+internal bool8
+HashMapResize(hash_map<key, value> *Map, uint64 NewCapacity)
+{
+    Assert(NewCapacity >= HASH_MAP_GROUP_SIZE && (NewCapacity & (NewCapacity - 1)) == 0, "Hash map capacity must be a power of two!");
+
+    memory_index SlotsOffset = AlignUpPow2(NewCapacity, alignof(hash_map_slot<key, value>));
+    memory_index TotalSize   = SlotsOffset + (NewCapacity * sizeof(hash_map_slot<key, value>));
+
+    uint8 *Memory = Map->Arena ? (uint8 *)PushSize_(Map->Arena, TotalSize, CACHE_LINE_SIZE) : (uint8 *)malloc(TotalSize);
+    if(!Memory)
+    {
+        Log(LOG_ERROR, "Failed to allocate '%llu' bytes for a hash map of '%llu' slots!", (unsigned long long)TotalSize, (unsigned long long)NewCapacity);
+        return(false);
+    }
+
+    uint8                     *OldControl  = Map->Control;
+    hash_map_slot<key, value> *OldSlots    = Map->Slots;
+    uint64                     OldCapacity = Map->Capacity;
+
+    Map->Control  = Memory;
+    Map->Slots    = (hash_map_slot<key, value> *)(Memory + SlotsOffset);
+    Map->Capacity = NewCapacity;
+    memset(Map->Control, HASH_MAP_EMPTY, NewCapacity);
+
+    for(uint64 Index = 0;
+        Index < OldCapacity;
+        ++Index)
+    {
+        if(!(OldControl[Index] & 0x80))
+        {
+            uint64 Hash = HashMapHash(OldSlots[Index].Key);
+            uint64 Slot = HashMapFindFreeSlot(Map, Hash);
+            Map->Control[Slot] = (uint8)(Hash & 0x7F);
+            memcpy(Map->Slots + Slot, OldSlots + Index, sizeof(hash_map_slot<key, value>));
+        }
+    }
+    Map->GrowthLeft = HashMapGetMaxLoad(NewCapacity) - Map->Count;
+
+    if(OldControl && !Map->Arena) free(OldControl);
+    return(true);
+}
+
+template <typename key, typename value>
+internal bool8
+HashMapReserve(hash_map<key, value> *Map, uint64 Count)
+{
+    uint64 NewCapacity = HASH_MAP_GROUP_SIZE;
+    while(HashMapGetMaxLoad(NewCapacity) < Count) NewCapacity *= 2;
+
+    if(NewCapacity <= Map->Capacity) return(true);
+    return(HashMapResize(Map, NewCapacity));
+}
+
+template <typename key, typename value>
+internal inline value*
+HashMapFind(hash_map<key, value> *Map, const key &Key)
+{
+    hash_map_slot<key, value> *Slot = HashMapFindSlot(Map, Key, HashMapHash(Key));
+    return(Slot ? &Slot->Value : 0);
+}
+
+// NOTE(Sleepster): Overwrites the value if Key is already in the map
+template <typename key, typename value>
+internal value*
+HashMapInsert(hash_map<key, value> *Map, const key &Key, const value &Value)
+{
+    uint64 Hash = HashMapHash(Key);
+    hash_map_slot<key, value> *Existing = HashMapFindSlot(Map, Key, Hash);
+    if(Existing)
+    {
+        Existing->Value = Value;
+        return(&Existing->Value);
+    }
+
+    if(!Map->GrowthLeft)
+    {
+        // NOTE(Sleepster): If it's mostly tombstones a same size rehash is enough to clean them up
+        uint64 NewCapacity = Map->Capacity ? Map->Capacity : HASH_MAP_GROUP_SIZE;
+        if(Map->Count >= (HashMapGetMaxLoad(NewCapacity) / 2)) NewCapacity *= 2;
+        if(!HashMapResize(Map, NewCapacity)) return(0);
+    }
+
+    uint64 Index = HashMapFindFreeSlot(Map, Hash);
+    if(Map->Control[Index] == HASH_MAP_EMPTY) --Map->GrowthLeft;
+
+    Map->Control[Index]     = (uint8)(Hash & 0x7F);
+    Map->Slots[Index].Key   = Key;
+    Map->Slots[Index].Value = Value;
+    ++Map->Count;
+
+    return(&Map->Slots[Index].Value);
+}
+
+template <typename key, typename value>
+internal bool8
+HashMapErase(hash_map<key, value> *Map, const key &Key)
+{
+    hash_map_slot<key, value> *Slot = HashMapFindSlot(Map, Key, HashMapHash(Key));
+    if(!Slot) return(false);
+
+    // NOTE(Sleepster): If the group already has an EMPTY no probe ever went past it, so this
+    // slot can go straight back to EMPTY instead of leaving a tombstone
+    uint64 Index = Slot - Map->Slots;
+    uint8 *Group = Map->Control + (Index & ~(uint64)(HASH_MAP_GROUP_SIZE - 1));
+    if(HashMapMatchByte(Group, HASH_MAP_EMPTY))
+    {
+        Map->Control[Index] = HASH_MAP_EMPTY;
+        ++Map->GrowthLeft;
+    }
+    else
+    {
+        Map->Control[Index] = HASH_MAP_DELETED;
+    }
+    --Map->Count;
+
+    return(true);
+}
+
+template <typename key, typename value>
+internal void
+HashMapClear(hash_map<key, value> *Map)
+{
+    if(Map->Capacity)
+    {
+        memset(Map->Control, HASH_MAP_EMPTY, Map->Capacity);
+    }
+    Map->Count      = 0;
+    Map->GrowthLeft = HashMapGetMaxLoad(Map->Capacity);
+}
+
+// NOTE(Sleepster): Only heap backed maps need this
+template <typename key, typename value>
+internal void
+HashMapDestroy(hash_map<key, value> *Map)
+{
+    if(Map->Control && !Map->Arena) free(Map->Control);
+
+    memory_arena *Arena = Map->Arena;
+    *Map = {};
+    Map->Arena = Arena;
+}
+
+// NOTE(Sleepster): Calls Callback(key *Key, value *Value) for every entry, don't insert while iterating
+template <typename key, typename value>
+internal void
+HashMapForEach(hash_map<key, value> *Map, auto Callback)
+{
+    for(uint64 Index = 0;
+        Index < Map->Capacity;
+        ++Index)
+    {
+        if(!(Map->Control[Index] & 0x80))
+        {
+            Callback(&Map->Slots[Index].Key, &Map->Slots[Index].Value);
+        }
+    }
+}
+
+#endif // HASH_MAP_H
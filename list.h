@@ -14,6 +14,14 @@
 constexpr int32 LIST_GROW_FACTOR  = 2;
 constexpr int32 DEFAULT_LIST_SIZE = 20;
 
+// NOTE(Sleepster): Define these before including list.h to take lists off of the CRT heap,
+// e.g. by pointing them at a tlsf_allocator. All three have to be defined together.
+#if !defined(ListAlloc)
+#define ListAlloc(Size)                 malloc(Size)
+#define ListRealloc(Memory, NewSize)    realloc(Memory, NewSize)
+#define ListFree(Memory)                free(Memory)
+#endif
+
 // NOTE(Sleepster): This is created outside of the normal memory
 // allocation strategy, therefore we should use it very sparingly
 struct list
@@ -36,27 +44,54 @@ _ListCreate(uint64 ElementSize, uint64 Capacity = DEFAULT_LIST_SIZE, int32 GrowF
     Result.Stride     = ElementSize;
     Result.Used       = 0;
     Result.GrowFactor = GrowFactor;
-    Result.Elements   = malloc((ElementSize * Capacity));
+    Result.Elements   = ListAlloc((ElementSize * Capacity));
+    AllocTrace(ALLOC_TRACE_LIST_CREATE, Result.Elements, ElementSize, Capacity);
     Log(LOG_TRACE, "List created...");
 
     return(Result);
 }
 
+// NOTE(Sleepster): Stride and GrowFactor are left alone so the list can be appended to again
 internal void
 ListDestroy(list *List)
 {
-    free(List->Elements);
+    AllocTrace(ALLOC_TRACE_LIST_DESTROY, List->Elements);
+    ListFree(List->Elements);
+    List->Elements = 0;
     List->Used     = 0;
-    List->Stride   = 0;
     List->Capacity = 0;
     Log(LOG_TRACE, "List has been destroyed...");
 }
 
+// NOTE(Sleepster): realloc gets to grow the block in place when there is room behind it
+internal inline void
+ListGrow(list *List)
+{
+    // NOTE(Sleepster): A list created with no room (or a destroyed one) would never get any bigger
+    uint64 GrowFactor  = List->GrowFactor >= 2 ? List->GrowFactor : LIST_GROW_FACTOR;
+    uint64 NewCapacity = List->Capacity ? List->Capacity * GrowFactor : DEFAULT_LIST_SIZE;
+    void *NewElements  = ListRealloc(List->Elements, List->Stride * NewCapacity);
+    Assert(NewElements, "NewElements Failed to Alloc...\n");
+
+    AllocTrace(ALLOC_TRACE_LIST_GROW, List->Elements, (uint64)NewElements, NewCapacity);
+    List->Capacity = NewCapacity;
+    List->Elements = NewElements;
+}
+
+internal inline void
+ListReserve(list *List, uint64 Capacity)
+{
+    while(List->Capacity < Capacity)
+    {
+        ListGrow(List);
+    }
+}
+
 // NOTE(Sleepster): This will always copy by value
 internal inline void
 ListAppendValue(list *List, auto Value)
 {
-    if(List->Used + 1 >= List->Capacity)
+    if(List->Used >= List->Capacity)
     {
         ListGrow(List);
     }
@@ -65,26 +100,29 @@ ListAppendValue(list *List, auto Value)
     ++List->Used;
 }
 
-
+// NOTE(Sleepster): Values is Count elements laid out back to back with the list's stride
 internal inline void
-ListGrow(list *List)
+ListAppendRange(list *List, void *Values, uint64 Count)
 {
-    void *NewElements = malloc(List->Stride * (List->Capacity * List->GrowFactor));
-    Assert(NewElements, "NewElements Failed to Alloc...\n");
+    // NOTE(Sleepster): Appending part of the list to itself, find Values again once it's grown
+    uint8 *Start   = (uint8 *)List->Elements;
+    bool8  Aliases = Start && (uint8 *)Values >= Start && (uint8 *)Values < Start + (List->Used * List->Stride);
+    uint64 Offset  = Aliases ? (uint64)((uint8 *)Values - Start) : 0;
 
-    memcpy(List->Elements, NewElements, List->Stride * List->Capacity);
-    free(List->Elements);
-        
-    List->Capacity *= List->GrowFactor;
-    List->Elements = NewElements;
+    ListReserve(List, List->Used + Count);
+    if(Aliases) Values = (uint8 *)List->Elements + Offset;
+
+    uint8 *Destination = (uint8 *)List->Elements + (List->Used * List->Stride);
+    memcpy(Destination, Values, Count * List->Stride);
+    List->Used += Count;
 }
 
 internal inline void*
 ListGetValueAtIndex(list *List, int32 Index)
 {
-    if(Index >= List->Capacity)
+    if(Index < 0 || (uint64)Index >= List->Used)
     {
-        Log(LOG_ERROR, "Index '%d' is invalid... List capacity is '%'...", Index, List->Capacity);
+        Log(LOG_ERROR, "Index '%d' is invalid... List has '%llu' elements...", Index, (unsigned long long)List->Used);
         return(nullptr);
     }
     uint8 *Value = (uint8 *)List->Elements + (Index * List->Stride);
@@ -94,54 +132,125 @@ ListGetValueAtIndex(list *List, int32 Index)
 internal inline bool8 
 ListSetValueAtIndex(list *List, int32 Index, void *Value)
 {
-    if(Index >= List->Capacity)
+    if(Index < 0 || (uint64)Index >= List->Used)
     {
         Log(LOG_ERROR, "Failed to set value at index '%d', index is invalid!...", Index);
         return(false);
     }
     
     uint8 *ListValue = (uint8 *)List->Elements + (Index * List->Stride);
-    ListValue = (uint8 *)Value;
+    memcpy(ListValue, Value, List->Stride);
 
     return(true);
 }
 
+// NOTE(Sleepster): Moves the last element into the hole, so the order is not kept
 internal bool8 
 ListRemoveValueAtIndex(list *List, int32 Index)
 {
-    if(Index > List->Capacity)
+    if(Index < 0 || (uint64)Index >= List->Used)
     {
-        Log(LOG_ERROR, "Index '%' is larger than the List's capacity!...", Index);
+        Log(LOG_ERROR, "Index '%d' is past the end of the list ('%llu')!...", Index, (unsigned long long)List->Used);
         return(false);
     }
 
-    if(List->Used == 1)
+    --List->Used;
+    if((uint64)Index != List->Used)
     {
-        List->Used = 0;
-        return(true);
+        uint8 *ElementPtr = (uint8*)List->Elements + (Index * List->Stride);
+        uint8 *LastPtr    = (uint8*)List->Elements + (List->Used * List->Stride);
+        memcpy(ElementPtr, LastPtr, List->Stride);
+    }
+
+    return(true);
+}
+
+// NOTE(Sleepster): Removes Count elements starting at Index and slides the rest down to keep the order
+internal bool8
+ListRemoveOrdered(list *List, int32 Index, uint64 Count = 1)
+{
+    if(Index < 0 || ((uint64)Index + Count) > List->Used)
+    {
+        Log(LOG_ERROR, "Range '%d' + '%llu' is past the end of the list ('%llu')!...",
+            Index, (unsigned long long)Count, (unsigned long long)List->Used);
+        return(false);
     }
 
-    --List->Used;
     uint8 *ElementPtr = (uint8*)List->Elements + (Index * List->Stride);
-    uint8 *DataEndPtr = (uint8*)List->Elements + (List->Capacity * List->Stride);
-    memcpy(ElementPtr, DataEndPtr, List->Stride);
+    memmove(ElementPtr, ElementPtr + (Count * List->Stride), (List->Used - Index - Count) * List->Stride);
+    List->Used -= Count;
 
     return(true);
 }
 
-// IMPORTANT(Sleepster): If you use this, the "Used" value of the list no longer matters...
-internal inline void 
+// NOTE(Sleepster): Makes room for all Count values with a single memmove
+internal bool8
+ListInsertRange(list *List, int32 Index, void *Values, uint64 Count)
+{
+    if(Index < 0 || (uint64)Index > List->Used)
+    {
+        Log(LOG_ERROR, "Index '%d' is past the end of the list ('%llu')!...", Index, (unsigned long long)List->Used);
+        return(false);
+    }
+
+    // NOTE(Sleepster): Values coming out of the list itself would be moved (or freed) out from
+    // under us, so they get copied out first
+    void  *Copy  = 0;
+    uint8 *Start = (uint8 *)List->Elements;
+    if(Start && (uint8 *)Values >= Start && (uint8 *)Values < Start + (List->Used * List->Stride))
+    {
+        Copy = ListAlloc(Count * List->Stride);
+        if(!Copy)
+        {
+            Log(LOG_ERROR, "Failed to copy '%llu' elements out of the list!", (unsigned long long)Count);
+            return(false);
+        }
+        memcpy(Copy, Values, Count * List->Stride);
+        Values = Copy;
+    }
+    ListReserve(List, List->Used + Count);
+
+    uint8 *ElementPtr = (uint8*)List->Elements + (Index * List->Stride);
+    memmove(ElementPtr + (Count * List->Stride), ElementPtr, (List->Used - Index) * List->Stride);
+    memcpy(ElementPtr, Values, Count * List->Stride);
+    List->Used += Count;
+
+    if(Copy) ListFree(Copy);
+    return(true);
+}
+
+internal inline bool8
 ListInsertValueAtIndex(list *List, int32 Index, void *Value)
 {
-    bool8 IndexIsValid = (Index > List->Capacity);
-    while(!IndexIsValid)
+    return(ListInsertRange(List, Index, Value, 1));
+}
+
+// NOTE(Sleepster): Predicate gets a void * to each element, anything it returns true for is
+// dropped. Survivors keep their order and everything is done in one pass.
+internal uint64
+ListRemoveIf(list *List, auto Predicate)
+{
+    uint8 *Elements = (uint8 *)List->Elements;
+    uint64 Kept     = 0;
+    for(uint64 Index = 0;
+        Index < List->Used;
+        ++Index)
     {
-        ListGrow(List);
-        if(Index < List->Capacity) break;
+        uint8 *Element = Elements + (Index * List->Stride);
+        if(!Predicate((void *)Element))
+        {
+            if(Kept != Index)
+            {
+                memcpy(Elements + (Kept * List->Stride), Element, List->Stride);
+            }
+            ++Kept;
+        }
     }
 
-    uint8 *Valueptr = (uint8 *)List->Elements + (List->Stride * Index);
-    memcpy(Value, Valueptr, List->Stride);
+    uint64 Removed = List->Used - Kept;
+    List->Used = Kept;
+
+    return(Removed);
 }
 
 internal inline void
@@ -0,0 +1,199 @@
+#if !defined(MORTON_GRID_H)
+/* ========================================================================
+   $File: morton_grid.h $
+   $Date: Sat, 17 Oct 26: 08:25PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define MORTON_GRID_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+#include "custom_math.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+constexpr int32 MORTON_GRID_TILE_SHIFT = 3;
+constexpr int32 MORTON_GRID_TILE_SIZE  = 1 << MORTON_GRID_TILE_SHIFT;
+constexpr int32 MORTON_GRID_TILE_MASK  = MORTON_GRID_TILE_SIZE - 1;
+constexpr int32 MORTON_GRID_TILE_CELLS = MORTON_GRID_TILE_SIZE * MORTON_GRID_TILE_SIZE;
+
+internal inline uint32
+MortonEncode2D(uint32 X, uint32 Y)
+{
+#if defined(__BMI2__)
+    return(_pdep_u32(X, 0x55555555) | _pdep_u32(Y, 0xAAAAAAAA));
+#else
+    uint32 Result = 0;
+    uint32 Coords[2] = {X & 0xFFFF, Y & 0xFFFF};
+    for(int32 Axis = 0;
+        Axis < 2;
+        ++Axis)
+    {
+        uint32 Value = Coords[Axis];
+        Value = (Value | (Value << 8)) & 0x00FF00FF;
+        Value = (Value | (Value << 4)) & 0x0F0F0F0F;
+        Value = (Value | (Value << 2)) & 0x33333333;
+        Value = (Value | (Value << 1)) & 0x55555555;
+        Result |= Value << Axis;
+    }
+    return(Result);
+#endif
+}
+
+internal inline ivec2
+MortonDecode2D(uint32 Code)
+{
+    ivec2 Result;
+#if defined(__BMI2__)
+    Result.X = (int32)_pext_u32(Code, 0x55555555);
+    Result.Y = (int32)_pext_u32(Code, 0xAAAAAAAA);
+#else
+    for(int32 Axis = 0;
+        Axis < 2;
+        ++Axis)
+    {
+        uint32 Value = (Code >> Axis) & 0x55555555;
+        Value = (Value | (Value >> 1)) & 0x33333333;
+        Value = (Value | (Value >> 2)) & 0x0F0F0F0F;
+        Value = (Value | (Value >> 4)) & 0x00FF00FF;
+        Value = (Value | (Value >> 8)) & 0x0000FFFF;
+        Result.Elements[Axis] = (int32)Value;
+    }
+#endif
+    return(Result);
+}
+
+// NOTE(Sleepster): 2D grid stored as 8x8 tiles, with the cells inside each tile in Z (Morton)
+// order so a cell's neighbors are almost always in the same cache line or the one next to it.
+// Tiles themselves are row-major so grids that aren't square powers of two don't waste memory.
+// The grid is padded out to whole tiles, the padding cells are never handed out.
+template <typename type>
+struct morton_grid
+{
+    int32  Width;
+    int32  Height;
+    int32  TilesX;
+    int32  TilesY;
+
+    type  *Cells;
+};
+
+template <typename type>
+internal morton_grid<type>
+InitializeMortonGrid(memory_arena *Arena, int32 Width, int32 Height)
+{
+    morton_grid<type> Result = {};
+    Result.TilesX = (Width  + MORTON_GRID_TILE_MASK) >> MORTON_GRID_TILE_SHIFT;
+    Result.TilesY = (Height + MORTON_GRID_TILE_MASK) >> MORTON_GRID_TILE_SHIFT;
+
+    memory_index CellCount = (memory_index)Result.TilesX * Result.TilesY * MORTON_GRID_TILE_CELLS;
+    Result.Cells = (type *)PushSizeZero_(Arena, CellCount * sizeof(type), CACHE_LINE_SIZE);
+    if(Result.Cells)
+    {
+        Result.Width  = Width;
+        Result.Height = Height;
+    }
+    else
+    {
+        Log(LOG_ERROR, "Failed to push a '%d'x'%d' morton grid!", Width, Height);
+    }
+
+    return(Result);
+}
+
+template <typename type>
+internal inline bool8
+MortonGridContains(morton_grid<type> *Grid, ivec2 Position)
+{
+    return((uint32)Position.X < (uint32)Grid->Width && (uint32)Position.Y < (uint32)Grid->Height);
+}
+
+template <typename type>
+internal inline uint64
+MortonGridGetIndex(morton_grid<type> *Grid, ivec2 Position)
+{
+    uint64 Tile  = ((uint64)(Position.Y >> MORTON_GRID_TILE_SHIFT) * Grid->TilesX) + (Position.X >> MORTON_GRID_TILE_SHIFT);
+    uint32 Local = MortonEncode2D(Position.X & MORTON_GRID_TILE_MASK, Position.Y & MORTON_GRID_TILE_MASK);
+
+    return((Tile << (2 * MORTON_GRID_TILE_SHIFT)) | Local);
+}
+
+template <typename type>
+internal inline ivec2
+MortonGridGetPosition(morton_grid<type> *Grid, uint64 Index)
+{
+    uint64 Tile  = Index >> (2 * MORTON_GRID_TILE_SHIFT);
+    ivec2 Result = MortonDecode2D((uint32)(Index & (MORTON_GRID_TILE_CELLS - 1)));
+    Result.X += (int32)(Tile % Grid->TilesX) << MORTON_GRID_TILE_SHIFT;
+    Result.Y += (int32)(Tile / Grid->TilesX) << MORTON_GRID_TILE_SHIFT;
+
+    return(Result);
+}
+
+// NOTE(Sleepster): No bounds check, use MortonGridGet if Position can be off the grid
+template <typename type>
+internal inline type*
+MortonGridAt(morton_grid<type> *Grid, ivec2 Position)
+{
+    Assert(MortonGridContains(Grid, Position), "Cell (%d, %d) is off the grid!", Position.X, Position.Y);
+    return(Grid->Cells + MortonGridGetIndex(Grid, Position));
+}
+
+template <typename type>
+internal inline type*
+MortonGridGet(morton_grid<type> *Grid, ivec2 Position)
+{
+    if(!MortonGridContains(Grid, Position)) return(0);
+    return(Grid->Cells + MortonGridGetIndex(Grid, Position));
+}
+
+// NOTE(Sleepster): Calls Callback(ivec2 Position, type *Cell) for every cell within Radius of
+// Position (a (2R + 1)^2 square, not including Position itself) that is on the grid
+template <typename type>
+internal void
+MortonGridForEachNeighbor(morton_grid<type> *Grid, ivec2 Position, auto Callback, int32 Radius = 1)
+{
+    int32 MinX = Position.X - Radius > 0 ? Position.X - Radius : 0;
+    int32 MinY = Position.Y - Radius > 0 ? Position.Y - Radius : 0;
+    int32 MaxX = Position.X + Radius < Grid->Width  - 1 ? Position.X + Radius : Grid->Width  - 1;
+    int32 MaxY = Position.Y + Radius < Grid->Height - 1 ? Position.Y + Radius : Grid->Height - 1;
+
+    for(int32 Y = MinY;
+        Y <= MaxY;
+        ++Y)
+    {
+        for(int32 X = MinX;
+            X <= MaxX;
+            ++X)
+        {
+            if(X == Position.X && Y == Position.Y) continue;
+
+            ivec2 Neighbor = {X, Y};
+            Callback(Neighbor, Grid->Cells + MortonGridGetIndex(Grid, Neighbor));
+        }
+    }
+}
+
+// NOTE(Sleepster): Walks the grid in storage order, which is the fastest way to touch every cell
+template <typename type>
+internal void
+MortonGridForEachCell(morton_grid<type> *Grid, auto Callback)
+{
+    uint64 CellCount = (uint64)Grid->TilesX * Grid->TilesY * MORTON_GRID_TILE_CELLS;
+    for(uint64 Index = 0;
+        Index < CellCount;
+        ++Index)
+    {
+        ivec2 Position = MortonGridGetPosition(Grid, Index);
+        if(MortonGridContains(Grid, Position))
+        {
+            Callback(Position, Grid->Cells + Index);
+        }
+    }
+}
+
+#endif // MORTON_GRID_H
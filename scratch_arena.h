@@ -0,0 +1,105 @@
+#if !defined(SCRATCH_ARENA_H)
+/* ========================================================================
+   $File: scratch_arena.h $
+   $Date: Sat, 17 Oct 26: 11:02AM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define SCRATCH_ARENA_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+
+#if !defined(SCRATCH_ARENA_COUNT)
+#define SCRATCH_ARENA_COUNT 2
+#endif
+
+#if !defined(SCRATCH_ARENA_RESERVE_SIZE)
+#define SCRATCH_ARENA_RESERVE_SIZE GB(1)
+#endif
+
+// NOTE(Sleepster): Every thread gets its own set of virtual arenas for temporary memory,
+// they are only reserved the first time the thread asks for scratch and are released
+// when the thread exits.
+struct thread_scratch_arenas
+{
+    memory_arena Arenas[SCRATCH_ARENA_COUNT];
+
+    ~thread_scratch_arenas()
+    {
+        for(int32 ArenaIndex = 0;
+            ArenaIndex < SCRATCH_ARENA_COUNT;
+            ++ArenaIndex)
+        {
+            if(Arenas[ArenaIndex].Base) ReleaseVirtualArena(&Arenas[ArenaIndex]);
+        }
+    }
+};
+
+global_variable thread_local thread_scratch_arenas ThreadScratchArenas;
+
+// NOTE(Sleepster): Ends the scratch block when it goes out of scope. Don't return
+// anything that was pushed onto Arena, it's gone as soon as this is.
+struct scratch_scope
+{
+    scratch_memory  Scratch;
+    memory_arena   *Arena;
+
+    scratch_scope(scratch_memory Memory) : Scratch(Memory), Arena(Memory.Arena) {}
+    ~scratch_scope() { EndScratchBlock(&Scratch); }
+
+    scratch_scope(const scratch_scope &) = delete;
+    scratch_scope &operator=(const scratch_scope &) = delete;
+};
+
+// NOTE(Sleepster): Hands back a scratch block on a thread arena that isn't one of the
+// Conflicts. Pass every arena you are going to push your *results* onto, otherwise
+// the scratch work and the results can end up sharing (and clobbering) the same arena.
+internal scratch_memory
+BeginThreadScratch(memory_arena **Conflicts, int32 ConflictCount)
+{
+    memory_arena *Result = 0;
+    for(int32 ArenaIndex = 0;
+        ArenaIndex < SCRATCH_ARENA_COUNT;
+        ++ArenaIndex)
+    {
+        memory_arena *Candidate = &ThreadScratchArenas.Arenas[ArenaIndex];
+
+        bool8 HasConflict = false;
+        for(int32 ConflictIndex = 0;
+            ConflictIndex < ConflictCount;
+            ++ConflictIndex)
+        {
+            if(Conflicts[ConflictIndex] == Candidate)
+            {
+                HasConflict = true;
+                break;
+            }
+        }
+
+        if(!HasConflict)
+        {
+            Result = Candidate;
+            break;
+        }
+    }
+    Assert(Result, "Every scratch arena is in the conflict list, bump SCRATCH_ARENA_COUNT...");
+
+    if(!Result->Base)
+    {
+        *Result = InitializeVirtualArena(SCRATCH_ARENA_RESERVE_SIZE);
+    }
+
+    return(BeginScratchBlock(Result));
+}
+
+template <typename ...conflict_types>
+internal inline scratch_scope
+GetScratch(conflict_types ...Conflicts)
+{
+    memory_arena *ConflictList[sizeof...(Conflicts) + 1] = {Conflicts...};
+    return(scratch_scope(BeginThreadScratch(ConflictList, sizeof...(Conflicts))));
+}
+
+#endif // SCRATCH_ARENA_H
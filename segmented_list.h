@@ -0,0 +1,155 @@
+#if !defined(SEGMENTED_LIST_H)
+/* ========================================================================
+   $File: segmented_list.h $
+   $Date: Sat, 17 Oct 26: 06:52PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define SEGMENTED_LIST_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+
+constexpr int32 SEGMENTED_LIST_MAX_SEGMENTS = 48;
+
+// NOTE(Sleepster): Growable list that never moves its elements, so pointers into it stay good
+// for as long as the arena does. Segment N holds FirstSegmentSize << N elements, which puts
+// element I in segment msb(I + FirstSegmentSize) - FirstSegmentShift. Segments come out of the
+// arena and are never given back, Reset keeps them around for reuse.
+struct segmented_list
+{
+    memory_arena *Arena;
+    uint64        Stride;
+    uint64        Used;
+    uint64        Capacity;
+
+    uint32        FirstSegmentShift;
+    uint32        SegmentCount;
+    void         *Segments[SEGMENTED_LIST_MAX_SEGMENTS];
+};
+
+#define SegmentedListCreate(Arena, type, ...)         _SegmentedListCreate(Arena, sizeof(type), ##__VA_ARGS__)
+#define SegmentedListGet(List, type, Index)  ((type *)SegmentedListGetValueAtIndex(List, Index))
+#define SegmentedListPush(List, type)        ((type *)SegmentedListPush_(List))
+
+internal inline uint32
+SegmentedListLog2(uint64 Value)
+{
+#if _MSC_VER
+    unsigned long Index;
+    _BitScanReverse64(&Index, Value);
+    return((uint32)Index);
+#else
+    return(63 - __builtin_clzll(Value));
+#endif
+}
+
+// NOTE(Sleepster): FirstSegmentSize gets rounded up to a power of two
+internal segmented_list
+_SegmentedListCreate(memory_arena *Arena, uint64 ElementSize, uint64 FirstSegmentSize = 16)
+{
+    segmented_list Result = {};
+    Result.Arena  = Arena;
+    Result.Stride = ElementSize;
+    Result.FirstSegmentShift = SegmentedListLog2(FirstSegmentSize);
+    if(((uint64)1 << Result.FirstSegmentShift) < FirstSegmentSize) ++Result.FirstSegmentShift;
+
+    return(Result);
+}
+
+internal inline uint64
+SegmentedListGetSegmentSize(segmented_list *List, uint32 Segment)
+{
+    return((uint64)1 << (List->FirstSegmentShift + Segment));
+}
+
+internal bool8
+SegmentedListAddSegment(segmented_list *List)
+{
+    if(List->SegmentCount >= SEGMENTED_LIST_MAX_SEGMENTS)
+    {
+        Log(LOG_ERROR, "Segmented list is out of segments!");
+        return(false);
+    }
+
+    uint64 SegmentSize = SegmentedListGetSegmentSize(List, List->SegmentCount);
+    void *Segment = PushSize_(List->Arena, SegmentSize * List->Stride, List->Stride >= 16 ? 16 : 8);
+    if(!Segment) return(false);
+
+    List->Segments[List->SegmentCount++] = Segment;
+    List->Capacity += SegmentSize;
+
+    return(true);
+}
+
+// NOTE(Sleepster): No bounds check, doesn't read Used so it's fine to call while another thread
+// is pushing as long as Index was pushed before you got hold of it
+internal inline void*
+SegmentedListGetSlot(segmented_list *List, uint64 Index)
+{
+    uint64 Biased  = Index + ((uint64)1 << List->FirstSegmentShift);
+    uint32 Segment = SegmentedListLog2(Biased) - List->FirstSegmentShift;
+    uint64 Offset  = Biased - ((uint64)1 << (Segment + List->FirstSegmentShift));
+
+    return((uint8 *)List->Segments[Segment] + (Offset * List->Stride));
+}
+
+internal inline void*
+SegmentedListGetValueAtIndex(segmented_list *List, uint64 Index)
+{
+    if(Index >= List->Used)
+    {
+        Log(LOG_ERROR, "Index '%llu' is invalid... List size is '%llu'...", (unsigned long long)Index, (unsigned long long)List->Used);
+        return(nullptr);
+    }
+
+    return(SegmentedListGetSlot(List, Index));
+}
+
+// NOTE(Sleepster): Hands back the slot for a new element, its contents are whatever was there
+internal void*
+SegmentedListPush_(segmented_list *List)
+{
+    if(List->Used >= List->Capacity)
+    {
+        if(!SegmentedListAddSegment(List)) return(0);
+    }
+
+    ++List->Used;
+    return(SegmentedListGetValueAtIndex(List, List->Used - 1));
+}
+
+// NOTE(Sleepster): This will always copy by value
+internal inline void*
+SegmentedListAppendValue(segmented_list *List, auto Value)
+{
+    Assert(sizeof(Value) == List->Stride, "Value does not match the segmented list's stride!");
+
+    void *Result = SegmentedListPush_(List);
+    if(Result)
+    {
+        memcpy(Result, &Value, List->Stride);
+    }
+
+    return(Result);
+}
+
+internal bool8
+SegmentedListReserve(segmented_list *List, uint64 Capacity)
+{
+    while(List->Capacity < Capacity)
+    {
+        if(!SegmentedListAddSegment(List)) return(false);
+    }
+
+    return(true);
+}
+
+internal inline void
+SegmentedListReset(segmented_list *List)
+{
+    List->Used = 0;
+}
+
+#endif // SEGMENTED_LIST_H
@@ -0,0 +1,211 @@
+#if !defined(SLAB_POOL_H)
+/* ========================================================================
+   $File: slab_pool.h $
+   $Date: Sat, 17 Oct 26: 11:41AM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define SLAB_POOL_H
+#include "types.h"
+#include "defines.h"
+#include "debug.h"
+#include "arena.h"
+
+constexpr uint32 DEFAULT_SLAB_ELEMENT_COUNT = 256;
+constexpr uint32 SLAB_CACHE_BATCH_SIZE      = 32;
+
+// NOTE(Sleepster): Freed elements store the link to the next free element in their own memory
+struct slab_free_node
+{
+    slab_free_node *Next;
+};
+
+// NOTE(Sleepster): Fixed size object pool. Slabs are pushed onto Arena and never given back,
+// individual elements are recycled through FreeList, so both alloc and free are O(1).
+struct slab_pool
+{
+    memory_arena   *Arena;
+    slab_free_node *FreeList;
+
+    uint8          *SlabCursor;
+    uint8          *SlabEnd;
+
+    memory_index    ElementSize;
+    memory_index    Alignment;
+    uint32          ElementsPerSlab;
+    uint32          SlabCount;
+
+    volatile int32  Lock;
+};
+
+// NOTE(Sleepster): Per-thread front for a shared slab_pool, only takes the pool's lock
+// once every SLAB_CACHE_BATCH_SIZE allocations/frees
+struct slab_cache
+{
+    slab_pool      *Pool;
+    slab_free_node *FreeList;
+    uint32          Count;
+};
+
+#define SlabPoolCreate(Arena, type, ...)  _SlabPoolCreate(Arena, sizeof(type), alignof(type), ##__VA_ARGS__)
+#define SlabAlloc(Pool, type)             (type *)SlabAlloc_(Pool)
+#define SlabCacheAlloc(Cache, type)       (type *)SlabCacheAlloc_(Cache)
+
+internal slab_pool
+_SlabPoolCreate(memory_arena *Arena, memory_index ElementSize, memory_index Alignment, uint32 ElementsPerSlab = DEFAULT_SLAB_ELEMENT_COUNT)
+{
+    if(Alignment < alignof(slab_free_node))  Alignment   = alignof(slab_free_node);
+    if(ElementSize < sizeof(slab_free_node)) ElementSize = sizeof(slab_free_node);
+    if(ElementsPerSlab < 1)                  ElementsPerSlab = 1;
+
+    slab_pool Result       = {};
+    Result.Arena           = Arena;
+    Result.ElementSize     = AlignUpPow2(ElementSize, Alignment);
+    Result.Alignment       = Alignment;
+    Result.ElementsPerSlab = ElementsPerSlab;
+
+    return(Result);
+}
+
+internal void*
+SlabAlloc_(slab_pool *Pool)
+{
+    void *Result = 0;
+    if(Pool->FreeList)
+    {
+        Result = Pool->FreeList;
+        Pool->FreeList = Pool->FreeList->Next;
+    }
+    else
+    {
+        if(Pool->SlabCursor == Pool->SlabEnd)
+        {
+            memory_index SlabSize = Pool->ElementSize * Pool->ElementsPerSlab;
+            Pool->SlabCursor = (uint8 *)PushSize_(Pool->Arena, SlabSize, Pool->Alignment);
+            if(!Pool->SlabCursor)
+            {
+                Pool->SlabEnd = 0;
+                return(0);
+            }
+
+            Pool->SlabEnd = Pool->SlabCursor + SlabSize;
+            ++Pool->SlabCount;
+        }
+
+        Result = Pool->SlabCursor;
+        Pool->SlabCursor += Pool->ElementSize;
+    }
+
+    return(Result);
+}
+
+internal inline void
+SlabFree(slab_pool *Pool, void *Element)
+{
+    if(Element)
+    {
+        slab_free_node *Node = (slab_free_node *)Element;
+        Node->Next = Pool->FreeList;
+        Pool->FreeList = Node;
+    }
+}
+
+// NOTE(Sleepster): Forgets every element at once, the slabs stay on the arena
+internal inline void
+SlabPoolReset(slab_pool *Pool)
+{
+    Pool->FreeList   = 0;
+    Pool->SlabCursor = 0;
+    Pool->SlabEnd    = 0;
+}
+
+internal inline void
+SlabPoolLock(slab_pool *Pool)
+{
+    while(AtomicCompareExchange32(&Pool->Lock, 0, 1) != 0) {}
+}
+
+internal inline void
+SlabPoolUnlock(slab_pool *Pool)
+{
+    AtomicCompareExchange32(&Pool->Lock, 1, 0);
+}
+
+internal inline slab_cache
+InitializeSlabCache(slab_pool *Pool)
+{
+    slab_cache Result = {};
+    Result.Pool = Pool;
+
+    return(Result);
+}
+
+internal void*
+SlabCacheAlloc_(slab_cache *Cache)
+{
+    if(!Cache->FreeList)
+    {
+        slab_pool *Pool = Cache->Pool;
+
+        SlabPoolLock(Pool);
+        for(uint32 Index = 0;
+            Index < SLAB_CACHE_BATCH_SIZE;
+            ++Index)
+        {
+            slab_free_node *Node = (slab_free_node *)SlabAlloc_(Pool);
+            if(!Node) break;
+
+            Node->Next = Cache->FreeList;
+            Cache->FreeList = Node;
+            ++Cache->Count;
+        }
+        SlabPoolUnlock(Pool);
+
+        if(!Cache->FreeList) return(0);
+    }
+
+    slab_free_node *Result = Cache->FreeList;
+    Cache->FreeList = Result->Next;
+    --Cache->Count;
+
+    return(Result);
+}
+
+// NOTE(Sleepster): Hands back up to Count elements from the cache to the shared pool
+internal void
+SlabCacheFlush(slab_cache *Cache, uint32 Count = UINT32_MAX)
+{
+    slab_pool *Pool = Cache->Pool;
+
+    SlabPoolLock(Pool);
+    while(Cache->FreeList && Count--)
+    {
+        slab_free_node *Node = Cache->FreeList;
+        Cache->FreeList = Node->Next;
+        --Cache->Count;
+
+        Node->Next = Pool->FreeList;
+        Pool->FreeList = Node;
+    }
+    SlabPoolUnlock(Pool);
+}
+
+internal inline void
+SlabCacheFree(slab_cache *Cache, void *Element)
+{
+    if(Element)
+    {
+        slab_free_node *Node = (slab_free_node *)Element;
+        Node->Next = Cache->FreeList;
+        Cache->FreeList = Node;
+        ++Cache->Count;
+
+        if(Cache->Count > (SLAB_CACHE_BATCH_SIZE * 2))
+        {
+            SlabCacheFlush(Cache, SLAB_CACHE_BATCH_SIZE);
+        }
+    }
+}
+
+#endif // SLAB_POOL_H
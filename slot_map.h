@@ -0,0 +1,204 @@
+#if !defined(SLOT_MAP_H)
+/* ========================================================================
+   $File: slot_map.h $
+   $Date: Sat, 17 Oct 26: 10:21PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define SLOT_MAP_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+
+#pragma push_macro("internal")
+#undef internal
+#include <type_traits>
+#pragma pop_macro("internal")
+
+constexpr uint32 SLOT_MAP_NO_SLOT = 0xFFFFFFFF;
+
+// NOTE(Sleepster): Generation 0 is never handed out, so a zeroed handle is always invalid
+struct slot_handle
+{
+    uint32 Index;
+    uint32 Generation;
+};
+
+internal inline bool32
+operator==(slot_handle A, slot_handle B)
+{
+    return(A.Index == B.Index && A.Generation == B.Generation);
+}
+
+struct slot_map_slot
+{
+    uint32 DenseIndex; // NOTE(Sleepster): Next free slot while it's on the free list
+    uint32 Generation;
+};
+
+// NOTE(Sleepster): Objects live packed together in Dense so iterating is a straight walk over
+// an array, handles go through Slots to find them. Removing swaps the last object into the hole
+// and bumps the slot's generation so old handles stop resolving. Growing pushes bigger arrays
+// out of the arena and leaves the old ones behind, so objects can move and pointers into Dense
+// don't survive an insert. Hold onto handles instead.
+template <typename type>
+struct slot_map
+{
+    static_assert(std::is_trivially_copyable<type>::value, "slot_map moves its objects around with memcpy");
+
+    memory_arena  *Arena;
+    uint32         Count;
+    uint32         Capacity;
+    uint32         SlotCount;
+    uint32         FreeSlot;
+
+    type          *Dense;
+    uint32        *DenseToSlot;
+    slot_map_slot *Slots;
+
+    type *begin() { return(Dense); }
+    type *end()   { return(Dense + Count); }
+};
+
+template <typename type>
+internal bool8
+SlotMapGrow(slot_map<type> *Map, uint32 NewCapacity)
+{
+    type          *Dense       = (type *)PushSize_(Map->Arena, NewCapacity * sizeof(type), alignof(type) > 4 ? alignof(type) : 4);
+    uint32        *DenseToSlot = PushArray(Map->Arena, uint32, NewCapacity);
+    slot_map_slot *Slots       = PushArray(Map->Arena, slot_map_slot, NewCapacity);
+    if(!Dense || !DenseToSlot || !Slots)
+    {
+        Log(LOG_ERROR, "Failed to grow the slot map to '%u' objects!", NewCapacity);
+        return(false);
+    }
+
+    if(Map->Capacity)
+    {
+        memcpy(Dense,       Map->Dense,       Map->Count * sizeof(type));
+        memcpy(DenseToSlot, Map->DenseToSlot, Map->Count * sizeof(uint32));
+        memcpy(Slots,       Map->Slots,       Map->SlotCount * sizeof(slot_map_slot));
+    }
+
+    Map->Dense       = Dense;
+    Map->DenseToSlot = DenseToSlot;
+    Map->Slots       = Slots;
+    Map->Capacity    = NewCapacity;
+
+    return(true);
+}
+
+template <typename type>
+internal inline bool8
+InitializeSlotMap(slot_map<type> *Map, memory_arena *Arena, uint32 Capacity = 64)
+{
+    *Map = {};
+    Map->Arena    = Arena;
+    Map->FreeSlot = SLOT_MAP_NO_SLOT;
+
+    return(SlotMapGrow(Map, Capacity));
+}
+
+template <typename type>
+internal slot_handle
+SlotMapInsert(slot_map<type> *Map, const type &Value)
+{
+    slot_handle Result = {};
+    if(Map->Count >= Map->Capacity)
+    {
+        if(!SlotMapGrow(Map, Map->Capacity ? Map->Capacity * 2 : 64)) return(Result);
+    }
+
+    uint32 SlotIndex;
+    if(Map->FreeSlot != SLOT_MAP_NO_SLOT)
+    {
+        SlotIndex      = Map->FreeSlot;
+        Map->FreeSlot  = Map->Slots[SlotIndex].DenseIndex;
+    }
+    else
+    {
+        SlotIndex = Map->SlotCount++;
+        Map->Slots[SlotIndex].Generation = 1;
+    }
+
+    slot_map_slot *Slot = Map->Slots + SlotIndex;
+    Slot->DenseIndex = Map->Count;
+
+    Map->Dense[Map->Count]       = Value;
+    Map->DenseToSlot[Map->Count] = SlotIndex;
+    ++Map->Count;
+
+    Result.Index      = SlotIndex;
+    Result.Generation = Slot->Generation;
+    return(Result);
+}
+
+template <typename type>
+internal inline type*
+SlotMapGet(slot_map<type> *Map, slot_handle Handle)
+{
+    if(Handle.Index >= Map->SlotCount) return(0);
+
+    slot_map_slot *Slot = Map->Slots + Handle.Index;
+    if(Slot->Generation != Handle.Generation) return(0);
+
+    return(Map->Dense + Slot->DenseIndex);
+}
+
+template <typename type>
+internal inline bool8
+SlotMapIsValid(slot_map<type> *Map, slot_handle Handle)
+{
+    return(SlotMapGet(Map, Handle) != 0);
+}
+
+template <typename type>
+internal bool8
+SlotMapRemove(slot_map<type> *Map, slot_handle Handle)
+{
+    if(!SlotMapIsValid(Map, Handle)) return(false);
+
+    slot_map_slot *Slot = Map->Slots + Handle.Index;
+    uint32 DenseIndex = Slot->DenseIndex;
+    uint32 Last       = --Map->Count;
+    if(DenseIndex != Last)
+    {
+        Map->Dense[DenseIndex]       = Map->Dense[Last];
+        Map->DenseToSlot[DenseIndex] = Map->DenseToSlot[Last];
+        Map->Slots[Map->DenseToSlot[DenseIndex]].DenseIndex = DenseIndex;
+    }
+
+    // NOTE(Sleepster): Skip 0 when the generation wraps so zeroed handles stay invalid
+    if(!++Slot->Generation) Slot->Generation = 1;
+    Slot->DenseIndex = Map->FreeSlot;
+    Map->FreeSlot    = Handle.Index;
+
+    return(true);
+}
+
+// NOTE(Sleepster): Handle for the object at a Dense index, for when you're iterating
+template <typename type>
+internal inline slot_handle
+SlotMapGetHandle(slot_map<type> *Map, uint32 DenseIndex)
+{
+    Assert(DenseIndex < Map->Count, "Dense index '%u' is past the end of the slot map!", DenseIndex);
+
+    slot_handle Result;
+    Result.Index      = Map->DenseToSlot[DenseIndex];
+    Result.Generation = Map->Slots[Result.Index].Generation;
+    return(Result);
+}
+
+// NOTE(Sleepster): Every outstanding handle goes stale
+template <typename type>
+internal void
+SlotMapClear(slot_map<type> *Map)
+{
+    while(Map->Count)
+    {
+        SlotMapRemove(Map, SlotMapGetHandle(Map, Map->Count - 1));
+    }
+}
+
+#endif // SLOT_MAP_H
@@ -0,0 +1,145 @@
+#if !defined(SMALL_LIST_H)
+/* ========================================================================
+   $File: small_list.h $
+   $Date: Sat, 17 Oct 26: 07:15PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define SMALL_LIST_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+#include "list.h"
+
+#pragma push_macro("internal")
+#undef internal
+#include <type_traits>
+#pragma pop_macro("internal")
+
+// NOTE(Sleepster): List that keeps its first InlineCount elements inside itself, so short lists
+// never touch the allocator. Past that it spills into Arena if it has one, otherwise the heap.
+// Elements is null while the list is still inline, that way copying the struct around is fine.
+template <typename type, uint32 InlineCount = 8>
+struct small_list
+{
+    static_assert(std::is_trivially_copyable<type>::value, "small_list copies its elements by value with memcpy");
+
+    uint64        Capacity;
+    uint64        Used;
+    memory_arena *Arena;
+
+    type         *Elements;
+    type          Inline[InlineCount];
+};
+
+template <typename type, uint32 InlineCount = 8>
+internal inline small_list<type, InlineCount>
+SmallListCreate(memory_arena *Arena = 0)
+{
+    small_list<type, InlineCount> Result = {};
+    Result.Capacity = InlineCount;
+    Result.Arena    = Arena;
+
+    return(Result);
+}
+
+template <typename type, uint32 InlineCount>
+internal inline type*
+SmallListGetData(small_list<type, InlineCount> *List)
+{
+    return(List->Elements ? List->Elements : List->Inline);
+}
+
+// NOTE(Sleepster): A zeroed small_list works too, it just hasn't spilled yet
+template <typename type, uint32 InlineCount>
+internal inline uint64
+SmallListGetCapacity(small_list<type, InlineCount> *List)
+{
+    return(List->Elements ? List->Capacity : InlineCount);
+}
+
+template <typename type, uint32 InlineCount>
+internal bool8
+SmallListGrow(small_list<type, InlineCount> *List)
+{
+    uint64 NewCapacity = SmallListGetCapacity(List) * LIST_GROW_FACTOR;
+    type *NewElements  = 0;
+
+    if(List->Arena)
+    {
+        // NOTE(Sleepster): The old buffer stays behind in the arena until it gets cleared
+        NewElements = (type *)PushSize_(List->Arena, NewCapacity * sizeof(type), alignof(type));
+        if(NewElements) memcpy(NewElements, SmallListGetData(List), List->Used * sizeof(type));
+    }
+    else if(List->Elements)
+    {
+        NewElements = (type *)ListRealloc(List->Elements, NewCapacity * sizeof(type));
+    }
+    else
+    {
+        NewElements = (type *)ListAlloc(NewCapacity * sizeof(type));
+        if(NewElements) memcpy(NewElements, List->Inline, List->Used * sizeof(type));
+    }
+
+    if(!NewElements)
+    {
+        Log(LOG_ERROR, "Failed to grow the small list to '%llu' elements!", (unsigned long long)NewCapacity);
+        return(false);
+    }
+
+    List->Elements = NewElements;
+    List->Capacity = NewCapacity;
+
+    return(true);
+}
+
+// NOTE(Sleepster): This will always copy by value
+template <typename type, uint32 InlineCount>
+internal inline bool8
+SmallListAppendValue(small_list<type, InlineCount> *List, type Value)
+{
+    if(List->Used >= SmallListGetCapacity(List))
+    {
+        if(!SmallListGrow(List)) return(false);
+    }
+
+    SmallListGetData(List)[List->Used++] = Value;
+    return(true);
+}
+
+template <typename type, uint32 InlineCount>
+internal inline type*
+SmallListGetValueAtIndex(small_list<type, InlineCount> *List, uint64 Index)
+{
+    if(Index >= List->Used)
+    {
+        Log(LOG_ERROR, "Index '%llu' is invalid... List size is '%llu'...", (unsigned long long)Index, (unsigned long long)List->Used);
+        return(nullptr);
+    }
+
+    return(SmallListGetData(List) + Index);
+}
+
+template <typename type, uint32 InlineCount>
+internal inline void
+SmallListReset(small_list<type, InlineCount> *List)
+{
+    List->Used = 0;
+}
+
+// NOTE(Sleepster): Only heap spills need this, arena spills go away with the arena
+template <typename type, uint32 InlineCount>
+internal inline void
+SmallListDestroy(small_list<type, InlineCount> *List)
+{
+    if(List->Elements && !List->Arena)
+    {
+        ListFree(List->Elements);
+    }
+    List->Elements = 0;
+    List->Capacity = InlineCount;
+    List->Used     = 0;
+}
+
+#endif // SMALL_LIST_H
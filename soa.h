@@ -0,0 +1,112 @@
+#if !defined(SOA_H)
+/* ========================================================================
+   $File: soa.h $
+   $Date: Sat, 17 Oct 26: 07:58PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define SOA_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+
+#if !defined(SOA_COLUMN_ALIGNMENT)
+#define SOA_COLUMN_ALIGNMENT 64
+#endif
+
+// NOTE(Sleepster): Structure of arrays generator. List the fields once as an X-macro and you get
+// one contiguous, SOA_COLUMN_ALIGNMENT aligned column per field out of an arena:
+//
+//   #define PARTICLE_FIELDS(X) X(vec3, Position) X(vec3, Velocity) X(real32, Lifetime)
+//   DECLARE_SOA(particles, PARTICLE_FIELDS)
+//
+//   particles Particles;
+//   InitializeSoa(&Particles, &Arena, 4096);
+//   SoaPush(&Particles, {Position, Velocity, 2.0f});
+//   for(uint32 Index = 0; Index < Particles.Used; ++Index) Particles.Position[Index] += Particles.Velocity[Index] * dt;
+//
+// The capacity is fixed once it's initialized, arenas don't grow allocations in place.
+#define SOA_ELEMENT_FIELD(type, Name)  type Name;
+#define SOA_COLUMN_FIELD(type, Name)   type *Name;
+#define SOA_PUSH_COLUMN(type, Name)    Soa->Name = (type *)PushSize_(Arena, sizeof(type) * Capacity, SOA_COLUMN_ALIGNMENT); if(!Soa->Name) Success = false;
+#define SOA_STORE_COLUMN(type, Name)   Soa->Name[Index] = Element.Name;
+#define SOA_LOAD_COLUMN(type, Name)    Result.Name = Soa->Name[Index];
+#define SOA_MOVE_COLUMN(type, Name)    Soa->Name[Index] = Soa->Name[Last];
+
+#define DECLARE_SOA(Name, FIELDS)                                                   \
+    struct Name##_element                                                           \
+    {                                                                               \
+        FIELDS(SOA_ELEMENT_FIELD)                                                   \
+    };                                                                              \
+                                                                                    \
+    struct Name                                                                     \
+    {                                                                               \
+        uint32 Used;                                                                \
+        uint32 Capacity;                                                            \
+        FIELDS(SOA_COLUMN_FIELD)                                                    \
+    };                                                                              \
+                                                                                    \
+    internal inline bool8                                                           \
+    InitializeSoa(Name *Soa, memory_arena *Arena, uint32 Capacity)                  \
+    {                                                                               \
+        *Soa = {};                                                                  \
+        bool8 Success = true;                                                       \
+        FIELDS(SOA_PUSH_COLUMN)                                                     \
+        if(!Success)                                                                \
+        {                                                                           \
+            Log(LOG_ERROR, "Failed to push the columns of " #Name "!");             \
+            return(false);                                                          \
+        }                                                                           \
+        Soa->Capacity = Capacity;                                                   \
+        return(true);                                                               \
+    }                                                                               \
+                                                                                    \
+    internal inline int32                                                           \
+    SoaPush(Name *Soa, const Name##_element &Element)                               \
+    {                                                                               \
+        if(Soa->Used >= Soa->Capacity)                                              \
+        {                                                                           \
+            Log(LOG_ERROR, #Name " is full ('%u' elements)!", Soa->Capacity);       \
+            return(-1);                                                             \
+        }                                                                           \
+        uint32 Index = Soa->Used++;                                                 \
+        FIELDS(SOA_STORE_COLUMN)                                                    \
+        return((int32)Index);                                                       \
+    }                                                                               \
+                                                                                    \
+    internal inline Name##_element                                                  \
+    SoaGet(Name *Soa, uint32 Index)                                                 \
+    {                                                                               \
+        Assert(Index < Soa->Used, "Index '%u' is past the end of " #Name "!", Index); \
+        Name##_element Result;                                                      \
+        FIELDS(SOA_LOAD_COLUMN)                                                     \
+        return(Result);                                                             \
+    }                                                                               \
+                                                                                    \
+    internal inline void                                                            \
+    SoaSet(Name *Soa, uint32 Index, const Name##_element &Element)                  \
+    {                                                                               \
+        Assert(Index < Soa->Used, "Index '%u' is past the end of " #Name "!", Index); \
+        FIELDS(SOA_STORE_COLUMN)                                                    \
+    }                                                                               \
+                                                                                    \
+    /* NOTE(Sleepster): Moves the last element into the hole in every column */     \
+    internal inline void                                                            \
+    SoaSwapRemove(Name *Soa, uint32 Index)                                          \
+    {                                                                               \
+        Assert(Index < Soa->Used, "Index '%u' is past the end of " #Name "!", Index); \
+        uint32 Last = --Soa->Used;                                                  \
+        if(Index != Last)                                                           \
+        {                                                                           \
+            FIELDS(SOA_MOVE_COLUMN)                                                 \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    internal inline void                                                            \
+    SoaReset(Name *Soa)                                                             \
+    {                                                                               \
+        Soa->Used = 0;                                                              \
+    }
+
+#endif // SOA_H
@@ -0,0 +1,215 @@
+#if !defined(STRING_INTERN_H)
+/* ========================================================================
+   $File: string_intern.h $
+   $Date: Sat, 17 Oct 26: 09:40PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define STRING_INTERN_H
+#include "types.h"
+#include "defines.h"
+#include "debug.h"
+#include "arena.h"
+#include "custom_string.h"
+#include "hash_map.h"
+#include "segmented_list.h"
+
+// NOTE(Sleepster): Atom is published last, once it's non-zero the rest of the slot is valid
+struct string_intern_slot
+{
+    string          String;
+    uint32          Hash;
+    volatile uint32 Atom;
+};
+
+struct string_intern_index
+{
+    uint32              Capacity;
+    string_intern_slot *Slots;
+};
+
+// NOTE(Sleepster): Keeps one copy of every string it's given, so interned strings can be compared
+// by pointer (StringsMatch's fast path) or by atom. Atoms start at 1, 0 is never a valid atom.
+// Lookups don't lock: the slots are only ever filled in, never changed, and growing builds a
+// whole new index and publishes it, leaving the old one in the arena for anyone still reading it.
+// Interning a new string takes the lock. The arena must only be used by the table.
+struct string_intern_table
+{
+    memory_arena                 *Arena;
+    string_intern_index *volatile Index;
+    segmented_list                Atoms;
+
+    uint32                        Count;
+    volatile int32                Lock;
+};
+
+internal string_intern_index*
+StringInternCreateIndex(memory_arena *Arena, uint32 Capacity)
+{
+    memory_index Size = sizeof(string_intern_index) + (Capacity * sizeof(string_intern_slot));
+    string_intern_index *Result = (string_intern_index *)PushSizeZero_(Arena, Size, CACHE_LINE_SIZE);
+    if(Result)
+    {
+        Result->Capacity = Capacity;
+        Result->Slots    = (string_intern_slot *)(Result + 1);
+    }
+
+    return(Result);
+}
+
+// NOTE(Sleepster): InitialCapacity has to be a power of two
+internal bool8
+InitializeStringInternTable(string_intern_table *Table, memory_arena *Arena, uint32 InitialCapacity = 1024)
+{
+    Assert((InitialCapacity & (InitialCapacity - 1)) == 0, "InitialCapacity has to be a power of two!");
+
+    *Table = {};
+    Table->Arena = Arena;
+    Table->Atoms = SegmentedListCreate(Arena, string, 256);
+    Table->Index = StringInternCreateIndex(Arena, InitialCapacity);
+    if(!Table->Index)
+    {
+        Log(LOG_ERROR, "Failed to create a string intern table of '%u' slots!", InitialCapacity);
+        return(false);
+    }
+
+    return(true);
+}
+
+internal inline uint32
+StringInternHash(string String)
+{
+    return((uint32)HashMapHashBytes(String.Data, String.Length));
+}
+
+// NOTE(Sleepster): Lock free, returns the slot holding String or 0
+internal string_intern_slot*
+StringInternFindSlot(string_intern_index *Index, string String, uint32 Hash)
+{
+    uint32 Mask = Index->Capacity - 1;
+    for(uint32 Probe = Hash & Mask;
+        ;
+        Probe = (Probe + 1) & Mask)
+    {
+        string_intern_slot *Slot = Index->Slots + Probe;
+        if(!AtomicLoadAcquire32(&Slot->Atom)) return(0);
+        if(Slot->Hash == Hash && StringsMatch(Slot->String, String)) return(Slot);
+    }
+}
+
+internal inline string_intern_index*
+StringInternGetIndex(string_intern_table *Table)
+{
+    return((string_intern_index *)AtomicLoadAcquirePointer((void *volatile *)&Table->Index));
+}
+
+internal void
+StringInternPlaceSlot(string_intern_index *Index, string String, uint32 Hash, uint32 Atom)
+{
+    uint32 Mask = Index->Capacity - 1;
+    uint32 Probe = Hash & Mask;
+    while(Index->Slots[Probe].Atom) Probe = (Probe + 1) & Mask;
+
+    string_intern_slot *Slot = Index->Slots + Probe;
+    Slot->String = String;
+    Slot->Hash   = Hash;
+    AtomicStoreRelease32(&Slot->Atom, Atom);
+}
+
+// NOTE(Sleepster): Called with the lock held, keeps the index at most 3/4 full
+internal bool8
+StringInternGrow(string_intern_table *Table)
+{
+    string_intern_index *OldIndex = Table->Index;
+    string_intern_index *NewIndex = StringInternCreateIndex(Table->Arena, OldIndex->Capacity * 2);
+    if(!NewIndex) return(false);
+
+    for(uint32 SlotIndex = 0;
+        SlotIndex < OldIndex->Capacity;
+        ++SlotIndex)
+    {
+        string_intern_slot *Slot = OldIndex->Slots + SlotIndex;
+        if(Slot->Atom)
+        {
+            StringInternPlaceSlot(NewIndex, Slot->String, Slot->Hash, Slot->Atom);
+        }
+    }
+
+    AtomicStoreReleasePointer((void *volatile *)&Table->Index, NewIndex);
+    return(true);
+}
+
+// NOTE(Sleepster): Doesn't add String if it isn't there yet, never locks
+internal inline uint32
+StringInternFind(string_intern_table *Table, string String)
+{
+    string_intern_slot *Slot = StringInternFindSlot(StringInternGetIndex(Table), String, StringInternHash(String));
+    return(Slot ? Slot->Atom : 0);
+}
+
+internal string_intern_slot*
+StringIntern_(string_intern_table *Table, string String)
+{
+    uint32 Hash = StringInternHash(String);
+    string_intern_slot *Result = StringInternFindSlot(StringInternGetIndex(Table), String, Hash);
+    if(Result) return(Result);
+
+    while(AtomicCompareExchange32(&Table->Lock, 0, 1) != 0) {}
+
+    // NOTE(Sleepster): Someone else might have added it while we were waiting
+    Result = StringInternFindSlot(Table->Index, String, Hash);
+    if(!Result)
+    {
+        bool8 HasRoom = ((Table->Count + 1) * 4 <= Table->Index->Capacity * 3) || StringInternGrow(Table);
+
+        uint8 *Data = HasRoom ? (uint8 *)PushSize_(Table->Arena, String.Length + 1, 1) : 0;
+        string *AtomString = Data ? SegmentedListPush(&Table->Atoms, string) : 0;
+        if(AtomString)
+        {
+            memcpy(Data, String.Data, String.Length);
+            Data[String.Length] = 0;
+
+            *AtomString = string{String.Length, Data};
+            uint32 Atom = ++Table->Count;
+            StringInternPlaceSlot(Table->Index, *AtomString, Hash, Atom);
+
+            Result = StringInternFindSlot(Table->Index, String, Hash);
+        }
+        else
+        {
+            Log(LOG_ERROR, "String intern table is out of memory!");
+        }
+    }
+
+    AtomicCompareExchange32(&Table->Lock, 1, 0);
+    return(Result);
+}
+
+// NOTE(Sleepster): The returned string is the table's copy (null terminated), so two interned
+// strings match exactly when their Data pointers do
+internal inline string
+InternString(string_intern_table *Table, string String)
+{
+    string_intern_slot *Slot = StringIntern_(Table, String);
+    return(Slot ? Slot->String : NULLSTR);
+}
+
+internal inline uint32
+InternAtom(string_intern_table *Table, string String)
+{
+    string_intern_slot *Slot = StringIntern_(Table, String);
+    return(Slot ? Slot->Atom : 0);
+}
+
+// NOTE(Sleepster): Atom has to have come from this table
+internal inline string
+GetInternedString(string_intern_table *Table, uint32 Atom)
+{
+    Assert(Atom, "0 is not a valid atom!");
+
+    string *Result = (string *)SegmentedListGetSlot(&Table->Atoms, Atom - 1);
+    return(*Result);
+}
+
+#endif // STRING_INTERN_H
@@ -0,0 +1,425 @@
+#if !defined(TLSF_H)
+/* ========================================================================
+   $File: tlsf.h $
+   $Date: Sat, 17 Oct 26: 12:30PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define TLSF_H
+#include "types.h"
+#include "debug.h"
+#include "arena.h"
+
+#include <stddef.h>
+
+// NOTE(Sleepster): Two level segregated fit allocator. Free blocks are binned by the
+// highest set bit of their size (first level) and then by the next TLSF_SL_INDEX_COUNT_LOG2
+// bits (second level), two bitmaps tell us which bins have anything in them so finding a
+// block that fits is a couple of bit scans. Alloc, free and realloc are all O(1).
+constexpr memory_index TLSF_ALIGNMENT_LOG2      = 4;
+constexpr memory_index TLSF_ALIGNMENT           = 1 << TLSF_ALIGNMENT_LOG2;
+constexpr int32        TLSF_SL_INDEX_COUNT_LOG2 = 5;
+constexpr int32        TLSF_SL_INDEX_COUNT      = 1 << TLSF_SL_INDEX_COUNT_LOG2;
+constexpr int32        TLSF_FL_INDEX_MAX        = 40;
+constexpr int32        TLSF_FL_INDEX_SHIFT      = TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGNMENT_LOG2;
+constexpr int32        TLSF_FL_INDEX_COUNT      = TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1;
+constexpr memory_index TLSF_SMALL_BLOCK_SIZE    = (memory_index)1 << TLSF_FL_INDEX_SHIFT;
+constexpr memory_index TLSF_BLOCK_FREE          = 1;
+
+// NOTE(Sleepster): Size is the size of the payload that follows the header, the low bit
+// marks the block as free. The free list links live inside the payload of free blocks.
+struct tlsf_block
+{
+    tlsf_block   *PrevPhysical;
+    memory_index  Size;
+
+    tlsf_block   *NextFree;
+    tlsf_block   *PrevFree;
+};
+
+constexpr memory_index TLSF_BLOCK_HEADER_SIZE = offsetof(tlsf_block, NextFree);
+constexpr memory_index TLSF_MIN_BLOCK_SIZE    = sizeof(tlsf_block) - TLSF_BLOCK_HEADER_SIZE;
+constexpr memory_index TLSF_MAX_BLOCK_SIZE    = (memory_index)1 << (TLSF_FL_INDEX_MAX - 1);
+
+struct tlsf_allocator
+{
+    uint32      FLBitmap;
+    uint32      SLBitmap[TLSF_FL_INDEX_COUNT];
+    tlsf_block *FreeLists[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+
+    tlsf_block *FirstBlock;
+};
+
+struct tlsf_stats
+{
+    memory_index UsedBytes;
+    memory_index FreeBytes;
+    memory_index LargestFreeBlock;
+    uint32       UsedBlockCount;
+    uint32       FreeBlockCount;
+
+    // NOTE(Sleepster): 0 when all the free memory is one block, approaches 1 as it gets shredded
+    real32       Fragmentation;
+};
+
+internal inline int32
+TLSFFindLastSet(memory_index Value)
+{
+#if _MSC_VER
+    unsigned long Index;
+    _BitScanReverse64(&Index, Value);
+    return((int32)Index);
+#else
+    return(63 - __builtin_clzll(Value));
+#endif
+}
+
+internal inline int32
+TLSFFindFirstSet(uint32 Value)
+{
+#if _MSC_VER
+    unsigned long Index;
+    _BitScanForward(&Index, Value);
+    return((int32)Index);
+#else
+    return(__builtin_ctz(Value));
+#endif
+}
+
+internal inline memory_index
+TLSFBlockSize(tlsf_block *Block)
+{
+    return(Block->Size & ~TLSF_BLOCK_FREE);
+}
+
+internal inline bool8
+TLSFBlockIsFree(tlsf_block *Block)
+{
+    return((Block->Size & TLSF_BLOCK_FREE) != 0);
+}
+
+internal inline tlsf_block*
+TLSFNextPhysical(tlsf_block *Block)
+{
+    return((tlsf_block *)((uint8 *)Block + TLSF_BLOCK_HEADER_SIZE + TLSFBlockSize(Block)));
+}
+
+internal inline void*
+TLSFBlockToPointer(tlsf_block *Block)
+{
+    return((uint8 *)Block + TLSF_BLOCK_HEADER_SIZE);
+}
+
+internal inline tlsf_block*
+TLSFPointerToBlock(void *Pointer)
+{
+    return((tlsf_block *)((uint8 *)Pointer - TLSF_BLOCK_HEADER_SIZE));
+}
+
+internal inline void
+TLSFMappingInsert(memory_index Size, int32 *FL, int32 *SL)
+{
+    if(Size < TLSF_SMALL_BLOCK_SIZE)
+    {
+        *FL = 0;
+        *SL = (int32)(Size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT));
+    }
+    else
+    {
+        int32 LastSet = TLSFFindLastSet(Size);
+        *SL = (int32)(Size >> (LastSet - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+        *FL = LastSet - (TLSF_FL_INDEX_SHIFT - 1);
+    }
+}
+
+// NOTE(Sleepster): Rounds the size up to the next bin so that any block in the bin we land
+// in is big enough, that's what lets us take the head of the list without searching it
+internal inline void
+TLSFMappingSearch(memory_index Size, int32 *FL, int32 *SL)
+{
+    if(Size >= TLSF_SMALL_BLOCK_SIZE)
+    {
+        Size += ((memory_index)1 << (TLSFFindLastSet(Size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    TLSFMappingInsert(Size, FL, SL);
+}
+
+internal void
+TLSFInsertFreeBlock(tlsf_allocator *Allocator, tlsf_block *Block)
+{
+    int32 FL, SL;
+    TLSFMappingInsert(TLSFBlockSize(Block), &FL, &SL);
+
+    tlsf_block *Head = Allocator->FreeLists[FL][SL];
+    Block->NextFree = Head;
+    Block->PrevFree = 0;
+    if(Head) Head->PrevFree = Block;
+
+    Allocator->FreeLists[FL][SL] = Block;
+    Allocator->FLBitmap     |= (1U << FL);
+    Allocator->SLBitmap[FL] |= (1U << SL);
+}
+
+internal void
+TLSFRemoveFreeBlock(tlsf_allocator *Allocator, tlsf_block *Block)
+{
+    int32 FL, SL;
+    TLSFMappingInsert(TLSFBlockSize(Block), &FL, &SL);
+
+    if(Block->PrevFree) Block->PrevFree->NextFree = Block->NextFree;
+    if(Block->NextFree) Block->NextFree->PrevFree = Block->PrevFree;
+
+    if(Allocator->FreeLists[FL][SL] == Block)
+    {
+        Allocator->FreeLists[FL][SL] = Block->NextFree;
+        if(!Block->NextFree)
+        {
+            Allocator->SLBitmap[FL] &= ~(1U << SL);
+            if(!Allocator->SLBitmap[FL])
+            {
+                Allocator->FLBitmap &= ~(1U << FL);
+            }
+        }
+    }
+}
+
+internal tlsf_block*
+TLSFFindFreeBlock(tlsf_allocator *Allocator, memory_index Size)
+{
+    int32 FL, SL;
+    TLSFMappingSearch(Size, &FL, &SL);
+    if(FL >= TLSF_FL_INDEX_COUNT) return(0);
+
+    uint32 SLMap = Allocator->SLBitmap[FL] & (~0U << SL);
+    if(!SLMap)
+    {
+        uint32 FLMap = (FL + 1 < 32) ? (Allocator->FLBitmap & (~0U << (FL + 1))) : 0;
+        if(!FLMap) return(0);
+
+        FL    = TLSFFindFirstSet(FLMap);
+        SLMap = Allocator->SLBitmap[FL];
+    }
+    SL = TLSFFindFirstSet(SLMap);
+
+    return(Allocator->FreeLists[FL][SL]);
+}
+
+// NOTE(Sleepster): Cuts Block down to Size and puts whatever is left over back in the free lists
+internal void
+TLSFSplitBlock(tlsf_allocator *Allocator, tlsf_block *Block, memory_index Size)
+{
+    memory_index BlockSize = TLSFBlockSize(Block);
+    if(BlockSize >= (Size + sizeof(tlsf_block)))
+    {
+        tlsf_block *Remainder   = (tlsf_block *)((uint8 *)TLSFBlockToPointer(Block) + Size);
+        Remainder->PrevPhysical = Block;
+        Remainder->Size         = (BlockSize - Size - TLSF_BLOCK_HEADER_SIZE) | TLSF_BLOCK_FREE;
+
+        Block->Size = Size | (Block->Size & TLSF_BLOCK_FREE);
+        TLSFNextPhysical(Remainder)->PrevPhysical = Remainder;
+
+        tlsf_block *Next = TLSFNextPhysical(Remainder);
+        if(TLSFBlockIsFree(Next))
+        {
+            TLSFRemoveFreeBlock(Allocator, Next);
+            Remainder->Size += TLSF_BLOCK_HEADER_SIZE + TLSFBlockSize(Next);
+            TLSFNextPhysical(Remainder)->PrevPhysical = Remainder;
+        }
+
+        TLSFInsertFreeBlock(Allocator, Remainder);
+    }
+}
+
+internal inline memory_index
+TLSFAdjustSize(memory_index Size)
+{
+    memory_index Result = AlignUpPow2(Size, TLSF_ALIGNMENT);
+    if(Result < TLSF_MIN_BLOCK_SIZE) Result = TLSF_MIN_BLOCK_SIZE;
+
+    return(Result);
+}
+
+// NOTE(Sleepster): The allocator state lives at the front of the region it manages, so
+// this carves Size bytes out of the pool the same way InitializeArena does
+internal tlsf_allocator*
+InitializeTLSF(memory_pool *BlockBuffer, memory_index Size)
+{
+    uint8 *Memory = BlockBuffer->BlockOffset;
+    memory_index AlignmentOffset = GetAlignmentOffsetForAddress((memory_index)Memory, TLSF_ALIGNMENT);
+    memory_index ControlSize     = AlignUpPow2(sizeof(tlsf_allocator), TLSF_ALIGNMENT);
+
+    // NOTE(Sleepster): Room for the control block, the first free block and the end sentinel
+    memory_index MinimumSize = AlignmentOffset + ControlSize + (2 * TLSF_BLOCK_HEADER_SIZE) + AlignUpPow2(TLSF_MIN_BLOCK_SIZE, TLSF_ALIGNMENT);
+    if(Size < MinimumSize)
+    {
+        Log(LOG_ERROR, "TLSF region of '%llu' bytes is too small, it needs at least '%llu' bytes!",
+            (unsigned long long)Size, (unsigned long long)MinimumSize);
+        return(0);
+    }
+    if((memory_index)((Memory + Size) - (uint8 *)BlockBuffer->MemoryBlock) > BlockBuffer->BlockSize)
+    {
+        Log(LOG_ERROR, "Memory pool doesn't have room for a '%llu' byte TLSF region!", (unsigned long long)Size);
+        return(0);
+    }
+    BlockBuffer->BlockOffset += Size;
+
+    Memory += AlignmentOffset;
+    Size   -= AlignmentOffset;
+
+    tlsf_allocator *Allocator = (tlsf_allocator *)Memory;
+    memset(Allocator, 0, sizeof(tlsf_allocator));
+
+    // NOTE(Sleepster): One big free block followed by a zero sized, used sentinel so that
+    // walking off of the end of the region always finds a block that can't be merged
+    memory_index BlockSize = (Size - ControlSize - (2 * TLSF_BLOCK_HEADER_SIZE)) & ~(TLSF_ALIGNMENT - 1);
+    if(BlockSize > TLSF_MAX_BLOCK_SIZE) BlockSize = TLSF_MAX_BLOCK_SIZE;
+
+    tlsf_block *Block   = (tlsf_block *)(Memory + ControlSize);
+    Block->PrevPhysical = 0;
+    Block->Size         = BlockSize | TLSF_BLOCK_FREE;
+
+    tlsf_block *Sentinel   = TLSFNextPhysical(Block);
+    Sentinel->PrevPhysical = Block;
+    Sentinel->Size         = 0;
+
+    Allocator->FirstBlock = Block;
+    TLSFInsertFreeBlock(Allocator, Block);
+
+    Log(LOG_INFO, "TLSF allocator initialized with '%llu' usable bytes", (unsigned long long)BlockSize);
+    return(Allocator);
+}
+
+internal void*
+TLSFAlloc(tlsf_allocator *Allocator, memory_index Size)
+{
+    if(!Size || Size > TLSF_MAX_BLOCK_SIZE) return(0);
+    Size = TLSFAdjustSize(Size);
+
+    tlsf_block *Block = TLSFFindFreeBlock(Allocator, Size);
+    if(!Block)
+    {
+        Log(LOG_ERROR, "TLSF allocator is out of memory, failed to allocate '%llu' bytes!", (unsigned long long)Size);
+        return(0);
+    }
+
+    TLSFRemoveFreeBlock(Allocator, Block);
+    Block->Size &= ~TLSF_BLOCK_FREE;
+    TLSFSplitBlock(Allocator, Block, Size);
+
+    return(TLSFBlockToPointer(Block));
+}
+
+internal void
+TLSFFree(tlsf_allocator *Allocator, void *Pointer)
+{
+    if(!Pointer) return;
+
+    tlsf_block *Block = TLSFPointerToBlock(Pointer);
+    Assert(!TLSFBlockIsFree(Block), "Block is already free, double free?");
+    Block->Size |= TLSF_BLOCK_FREE;
+
+    tlsf_block *Prev = Block->PrevPhysical;
+    if(Prev && TLSFBlockIsFree(Prev))
+    {
+        TLSFRemoveFreeBlock(Allocator, Prev);
+        Prev->Size += TLSF_BLOCK_HEADER_SIZE + TLSFBlockSize(Block);
+        Block = Prev;
+    }
+
+    tlsf_block *Next = TLSFNextPhysical(Block);
+    if(TLSFBlockIsFree(Next))
+    {
+        TLSFRemoveFreeBlock(Allocator, Next);
+        Block->Size += TLSF_BLOCK_HEADER_SIZE + TLSFBlockSize(Next);
+    }
+
+    TLSFNextPhysical(Block)->PrevPhysical = Block;
+    TLSFInsertFreeBlock(Allocator, Block);
+}
+
+internal void*
+TLSFRealloc(tlsf_allocator *Allocator, void *Pointer, memory_index Size)
+{
+    if(!Pointer) return(TLSFAlloc(Allocator, Size));
+    if(!Size)
+    {
+        TLSFFree(Allocator, Pointer);
+        return(0);
+    }
+    if(Size > TLSF_MAX_BLOCK_SIZE) return(0);
+
+    tlsf_block   *Block       = TLSFPointerToBlock(Pointer);
+    memory_index  CurrentSize = TLSFBlockSize(Block);
+    memory_index  AdjustedSize = TLSFAdjustSize(Size);
+
+    // NOTE(Sleepster): Grow in place when the next block is free and big enough
+    tlsf_block *Next = TLSFNextPhysical(Block);
+    if(AdjustedSize > CurrentSize &&
+       TLSFBlockIsFree(Next) &&
+       (CurrentSize + TLSF_BLOCK_HEADER_SIZE + TLSFBlockSize(Next)) >= AdjustedSize)
+    {
+        TLSFRemoveFreeBlock(Allocator, Next);
+        Block->Size += TLSF_BLOCK_HEADER_SIZE + TLSFBlockSize(Next);
+        TLSFNextPhysical(Block)->PrevPhysical = Block;
+        CurrentSize = TLSFBlockSize(Block);
+    }
+
+    if(AdjustedSize <= CurrentSize)
+    {
+        TLSFSplitBlock(Allocator, Block, AdjustedSize);
+        return(Pointer);
+    }
+
+    void *Result = TLSFAlloc(Allocator, Size);
+    if(Result)
+    {
+        memcpy(Result, Pointer, CurrentSize);
+        TLSFFree(Allocator, Pointer);
+    }
+
+    return(Result);
+}
+
+// NOTE(Sleepster): Walks every block, this is for reporting and isn't O(1) like the rest
+internal tlsf_stats
+TLSFGetStats(tlsf_allocator *Allocator)
+{
+    tlsf_stats Result = {};
+    for(tlsf_block *Block = Allocator->FirstBlock;
+        TLSFBlockSize(Block) != 0;
+        Block = TLSFNextPhysical(Block))
+    {
+        memory_index BlockSize = TLSFBlockSize(Block);
+        if(TLSFBlockIsFree(Block))
+        {
+            Result.FreeBytes += BlockSize;
+            ++Result.FreeBlockCount;
+            if(BlockSize > Result.LargestFreeBlock) Result.LargestFreeBlock = BlockSize;
+        }
+        else
+        {
+            Result.UsedBytes += BlockSize;
+            ++Result.UsedBlockCount;
+        }
+    }
+
+    if(Result.FreeBytes)
+    {
+        Result.Fragmentation = 1.0f - ((real32)Result.LargestFreeBlock / (real32)Result.FreeBytes);
+    }
+
+    return(Result);
+}
+
+internal void
+TLSFLogStats(tlsf_allocator *Allocator)
+{
+    tlsf_stats Stats = TLSFGetStats(Allocator);
+    Log(LOG_INFO, "TLSF: used '%llu' bytes in '%u' blocks, free '%llu' bytes in '%u' blocks, largest free '%llu', fragmentation %.2f%%",
+        (unsigned long long)Stats.UsedBytes, Stats.UsedBlockCount,
+        (unsigned long long)Stats.FreeBytes, Stats.FreeBlockCount,
+        (unsigned long long)Stats.LargestFreeBlock, Stats.Fragmentation * 100.0f);
+}
+
+#endif // TLSF_H
@@ -0,0 +1,286 @@
+#if !defined(TYPED_LIST_H)
+/* ========================================================================
+   $File: typed_list.h $
+   $Date: Sat, 17 Oct 26: 06:20PM $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define TYPED_LIST_H
+#include "types.h"
+#include "debug.h"
+#include "list.h"
+
+#pragma push_macro("internal")
+#undef internal
+#include <new>
+#include <type_traits>
+#include <utility>
+#pragma pop_macro("internal")
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// NOTE(Sleepster): Once a trivially copyable list gets this big it moves into its own mapping,
+// after that growing it just remaps the pages instead of copying them (Linux only)
+#if !defined(TYPED_LIST_REMAP_THRESHOLD)
+#define TYPED_LIST_REMAP_THRESHOLD MB(1)
+#endif
+
+// NOTE(Sleepster): Typed version of list, elements are constructed, moved and destroyed
+// properly so things like move-only types work. Same heap rules as list apply.
+template <typename type>
+struct typed_list
+{
+    uint64  Capacity;
+    uint64  Used;
+    bool8   IsMapped;
+
+    type   *Elements;
+
+    type &operator[](uint64 Index)
+    {
+        Assert(Index < Used, "Index '%llu' is past the end of the list ('%llu')!", (unsigned long long)Index, (unsigned long long)Used);
+        return(Elements[Index]);
+    }
+
+    type *begin() { return(Elements); }
+    type *end()   { return(Elements + Used); }
+};
+
+template <typename type>
+internal typed_list<type>
+TypedListCreate(uint64 Capacity = DEFAULT_LIST_SIZE)
+{
+    typed_list<type> Result = {};
+    Result.Capacity = Capacity;
+    Result.Elements = (type *)ListAlloc(sizeof(type) * Capacity);
+    AllocTrace(ALLOC_TRACE_LIST_CREATE, Result.Elements, sizeof(type), Capacity);
+
+    return(Result);
+}
+
+template <typename type>
+internal void
+TypedListReset(typed_list<type> *List)
+{
+    if constexpr(!std::is_trivially_destructible<type>::value)
+    {
+        for(uint64 Index = 0;
+            Index < List->Used;
+            ++Index)
+        {
+            List->Elements[Index].~type();
+        }
+    }
+    List->Used = 0;
+}
+
+template <typename type>
+internal void
+TypedListDestroy(typed_list<type> *List)
+{
+    TypedListReset(List);
+    AllocTrace(ALLOC_TRACE_LIST_DESTROY, List->Elements);
+
+#if defined(__linux__)
+    if(List->IsMapped)
+    {
+        munmap(List->Elements, List->Capacity * sizeof(type));
+    }
+    else
+#endif
+    {
+        ListFree(List->Elements);
+    }
+    *List = {};
+}
+
+#if defined(__linux__)
+// NOTE(Sleepster): Hands back how many elements actually fit, the mapping is rounded up to a page
+template <typename type>
+internal uint64
+TypedListRemap(typed_list<type> *List, uint64 NewCapacity)
+{
+    memory_index PageSize = (memory_index)sysconf(_SC_PAGESIZE);
+    memory_index NewSize  = AlignUpPow2(NewCapacity * sizeof(type), PageSize);
+
+    void *NewElements = 0;
+    if(List->IsMapped)
+    {
+        NewElements = mremap(List->Elements, List->Capacity * sizeof(type), NewSize, MREMAP_MAYMOVE);
+    }
+    else
+    {
+        NewElements = mmap(0, NewSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if(NewElements != MAP_FAILED)
+        {
+            memcpy(NewElements, List->Elements, List->Used * sizeof(type));
+            ListFree(List->Elements);
+        }
+    }
+
+    if(NewElements == MAP_FAILED)
+    {
+        Log(LOG_ERROR, "Failed to remap the list to '%llu' bytes!", (unsigned long long)NewSize);
+        return(0);
+    }
+
+    AllocTrace(ALLOC_TRACE_LIST_GROW, List->Elements, (uint64)NewElements, NewSize / sizeof(type));
+    List->Elements = (type *)NewElements;
+    List->IsMapped = true;
+
+    return(NewSize / sizeof(type));
+}
+#endif
+
+template <typename type>
+internal bool8
+TypedListReserve(typed_list<type> *List, uint64 Capacity)
+{
+    if(Capacity <= List->Capacity) return(true);
+
+    uint64 NewCapacity = Capacity;
+    if constexpr(std::is_trivially_copyable<type>::value)
+    {
+#if defined(__linux__)
+        if((NewCapacity * sizeof(type)) >= TYPED_LIST_REMAP_THRESHOLD)
+        {
+            NewCapacity = TypedListRemap(List, NewCapacity);
+            if(!NewCapacity) return(false);
+
+            List->Capacity = NewCapacity;
+            return(true);
+        }
+#endif
+
+        type *NewElements = (type *)ListRealloc(List->Elements, NewCapacity * sizeof(type));
+        if(!NewElements)
+        {
+            Log(LOG_ERROR, "Failed to grow the list to '%llu' elements!", (unsigned long long)NewCapacity);
+            return(false);
+        }
+
+        AllocTrace(ALLOC_TRACE_LIST_GROW, List->Elements, (uint64)NewElements, NewCapacity);
+        List->Elements = NewElements;
+    }
+    else
+    {
+        // NOTE(Sleepster): realloc would just memcpy these, so they get moved over one by one
+        type *NewElements = (type *)ListAlloc(NewCapacity * sizeof(type));
+        if(!NewElements)
+        {
+            Log(LOG_ERROR, "Failed to grow the list to '%llu' elements!", (unsigned long long)NewCapacity);
+            return(false);
+        }
+
+        for(uint64 Index = 0;
+            Index < List->Used;
+            ++Index)
+        {
+            new(NewElements + Index) type(std::move(List->Elements[Index]));
+            List->Elements[Index].~type();
+        }
+
+        AllocTrace(ALLOC_TRACE_LIST_GROW, List->Elements, (uint64)NewElements, NewCapacity);
+        ListFree(List->Elements);
+        List->Elements = NewElements;
+    }
+    List->Capacity = NewCapacity;
+
+    return(true);
+}
+
+template <typename type>
+internal inline bool8
+TypedListGrowFor(typed_list<type> *List, uint64 Count)
+{
+    if((List->Used + Count) <= List->Capacity) return(true);
+
+    uint64 NewCapacity = List->Capacity ? List->Capacity * LIST_GROW_FACTOR : DEFAULT_LIST_SIZE;
+    while(NewCapacity < (List->Used + Count)) NewCapacity *= LIST_GROW_FACTOR;
+
+    return(TypedListReserve(List, NewCapacity));
+}
+
+template <typename type, typename... args>
+internal inline type*
+TypedListEmplace(typed_list<type> *List, args&&... Args)
+{
+    if(List->Used >= List->Capacity)
+    {
+        // NOTE(Sleepster): Args can point into Elements (TypedListAppend(&List, List[0])), so the
+        // element gets built before growing frees the buffer it lives in
+        type Value(std::forward<args>(Args)...);
+        if(!TypedListGrowFor(List, 1)) return(0);
+
+        type *Result = new(List->Elements + List->Used) type(std::move(Value));
+        ++List->Used;
+
+        return(Result);
+    }
+
+    type *Result = new(List->Elements + List->Used) type(std::forward<args>(Args)...);
+    ++List->Used;
+
+    return(Result);
+}
+
+template <typename type>
+internal inline type*
+TypedListAppend(typed_list<type> *List, const type &Value)
+{
+    return(TypedListEmplace(List, Value));
+}
+
+template <typename type>
+internal inline type*
+TypedListAppend(typed_list<type> *List, type &&Value)
+{
+    return(TypedListEmplace(List, std::move(Value)));
+}
+
+// NOTE(Sleepster): One grow for the whole range, trivially copyable types go over with a single memcpy
+template <typename type>
+internal bool8
+TypedListAppendRange(typed_list<type> *List, const type *Values, uint64 Count)
+{
+    // NOTE(Sleepster): Appending part of the list to itself, find Values again once it's grown
+    uintptr_t Source = (uintptr_t)Values;
+    uintptr_t Start  = (uintptr_t)List->Elements;
+    bool8 Aliases = List->Elements && Source >= Start && Source < (uintptr_t)(List->Elements + List->Used);
+    uint64 SourceIndex = Aliases ? (Source - Start) / sizeof(type) : 0;
+
+    if(!TypedListGrowFor(List, Count)) return(false);
+    if(Aliases) Values = List->Elements + SourceIndex;
+
+    if constexpr(std::is_trivially_copyable<type>::value)
+    {
+        memcpy(List->Elements + List->Used, Values, Count * sizeof(type));
+    }
+    else
+    {
+        for(uint64 Index = 0;
+            Index < Count;
+            ++Index)
+        {
+            new(List->Elements + List->Used + Index) type(Values[Index]);
+        }
+    }
+    List->Used += Count;
+
+    return(true);
+}
+
+template <typename type>
+internal inline void
+TypedListPop(typed_list<type> *List)
+{
+    Assert(List->Used, "Popping from an empty list!");
+    --List->Used;
+    List->Elements[List->Used].~type();
+}
+
+#endif // TYPED_LIST_H